@@ -0,0 +1,233 @@
+﻿// bench/create_room_bench.cpp
+// 동시에 방을 만들 때의 처리량/지연 시간 벤치마크
+// 기존 방식(트랜잭션 안에서 참가 여부 확인, 첫 TERMINATED 방 FOR UPDATE, 재활성화, INSERT 네 번 왕복)과
+// RoomStore::createRoomWithHost(메모리 빈 슬롯 할당 후 write-behind 큐로 전송)를 동시 호출 수별로 비교
+// 각 사용자는 방을 만든 직후 나가서 방을 다시 TERMINATED로 돌려놓으며, 방 생성 구간만 측정
+//
+// 서버와 같은 DB_HOST, DB_PORT, DB_USER, DB_PASSWORD, DB_NAME 환경 변수를 사용
+// 벤치마크용 사용자를 추가/삭제하고 종료된 방을 잠시 사용하므로 서버를 내린 개발용 DB에서 실행
+#include "repository/room_store.h"
+#include "repository/sql_statements.h"
+#include "util/db_pool.h"
+#include "util/write_behind_queue.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <pqxx/pqxx>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace game_server;
+
+namespace {
+
+    constexpr int kUserCount = 64;
+    constexpr int kCyclesPerUser = 20;
+    constexpr int kMaxPlayers = 8;
+    constexpr int kThreadCounts[] = { 1, 4, 16, 32 };
+
+    std::string envOr(const char* name, const char* fallback) {
+        const char* value = std::getenv(name);
+        return value ? value : fallback;
+    }
+
+    struct Stats {
+        double createsPerSecond = 0;
+        double p50Us = 0;
+        double p99Us = 0;
+        double persistMs = 0;   // 마지막 변경이 DB에 반영될 때까지 걸린 시간
+        int failed = 0;
+    };
+
+    // 벤치마크 전 종료된 방의 원래 값 (정리할 때 되돌림)
+    struct RoomSnapshot {
+        int roomId;
+        std::string roomName;
+        int hostId;
+        int maxPlayers;
+    };
+
+    // 사용자들을 스레드 수만큼 나누어 방 생성/퇴장을 반복하고 생성마다 걸린 시간(마이크로초) 기록
+    template <typename Create, typename Exit>
+    Stats runCycles(const std::vector<int>& users, int threadCount, Create create, Exit exit) {
+        std::vector<std::vector<double>> perThread(threadCount);
+        std::vector<int> failures(threadCount, 0);
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int cycle = 0; cycle < kCyclesPerUser; ++cycle) {
+                    for (std::size_t i = t; i < users.size(); i += threadCount) {
+                        auto begin = std::chrono::steady_clock::now();
+                        bool created = create(t, users[i]);
+                        perThread[t].push_back(std::chrono::duration<double, std::micro>(
+                            std::chrono::steady_clock::now() - begin).count());
+                        if (created) exit(t, users[i]);
+                        else ++failures[t];
+                    }
+                }
+                });
+        }
+        for (auto& thread : threads) thread.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::vector<double> latencies;
+        for (auto& values : perThread) latencies.insert(latencies.end(), values.begin(), values.end());
+        std::sort(latencies.begin(), latencies.end());
+
+        Stats stats;
+        stats.createsPerSecond = latencies.size() / seconds;
+        stats.p50Us = latencies[latencies.size() / 2];
+        stats.p99Us = latencies[latencies.size() * 99 / 100];
+        for (int count : failures) stats.failed += count;
+        return stats;
+    }
+
+    // 기존 RoomRepositoryImpl::createRoomWithHost와 같은 네 번의 왕복
+    bool legacyCreate(pqxx::connection& conn, int hostId) {
+        pqxx::work txn(conn);
+        auto isJoined = txn.exec_params("SELECT room_id FROM room_users WHERE user_id = $1 LIMIT 1", hostId);
+        if (!isJoined.empty()) return false;
+
+        auto idResult = txn.exec(
+            "SELECT room_id FROM rooms WHERE status = 'TERMINATED' ORDER BY room_id LIMIT 1 FOR UPDATE");
+        if (idResult.empty()) return false;
+        int roomId = idResult[0][0].as<int>();
+
+        auto roomResult = txn.exec_params(
+            "UPDATE rooms SET room_name = $1, host_id = $2, max_players = $3, "
+            "status = 'WAITING', created_at = DEFAULT "
+            "WHERE room_id = $4 AND status = 'TERMINATED' "
+            "RETURNING room_id, room_name, ip_address, port, max_players",
+            "bench", hostId, kMaxPlayers, roomId);
+        if (roomResult.empty()) return false;
+
+        txn.exec_params("INSERT INTO room_users(room_id, user_id) VALUES($1, $2)", roomId, hostId);
+        txn.commit();
+        return true;
+    }
+
+    // 기존 방식의 방 퇴장 (참가자가 없으므로 방도 종료)
+    void legacyExit(pqxx::connection& conn, int userId) {
+        pqxx::work txn(conn);
+        auto left = txn.exec_params("DELETE FROM room_users WHERE user_id = $1 RETURNING room_id", userId);
+        if (!left.empty()) {
+            txn.exec_params("UPDATE rooms SET status = 'TERMINATED' WHERE room_id = $1", left[0][0].as<int>());
+        }
+        txn.commit();
+    }
+
+    Stats benchLegacy(const std::string& connectionString, const std::vector<int>& users, int threadCount) {
+        std::vector<std::unique_ptr<pqxx::connection>> conns;
+        for (int t = 0; t < threadCount; ++t) {
+            conns.push_back(std::make_unique<pqxx::connection>(connectionString));
+        }
+
+        return runCycles(users, threadCount,
+            [&](int t, int userId) {
+                try {
+                    return legacyCreate(*conns[t], userId);
+                }
+                catch (const std::exception&) {
+                    // 동시 생성이 같은 방을 고른 경우 등은 실패로 집계
+                    return false;
+                }
+            },
+            [&](int t, int userId) { legacyExit(*conns[t], userId); });
+    }
+
+    Stats benchRoomStore(const std::string& connectionString, const std::vector<int>& users, int threadCount) {
+        DbPool pool(connectionString, 2, std::chrono::milliseconds(3000), prepareStatements);
+        WriteBehindQueue writeBehind(connectionString, statementCatalog());
+        RoomStore store(&pool, &writeBehind);
+        store.load();
+
+        Stats stats = runCycles(users, threadCount,
+            [&](int, int userId) { return store.createRoomWithHost(userId, "bench", kMaxPlayers)["roomId"].get<int>() > 0; },
+            [&](int, int userId) { store.removePlayer(userId); });
+
+        // 큐에 쌓인 변경이 모두 반영될 때까지의 시간
+        auto flushStart = std::chrono::steady_clock::now();
+        writeBehind.stop();
+        stats.persistMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - flushStart).count();
+        return stats;
+    }
+
+} // namespace
+
+int main() {
+    spdlog::set_level(spdlog::level::warn);
+
+    std::string connectionString =
+        "dbname=" + envOr("DB_NAME", "postgres") + " user=" + envOr("DB_USER", "postgres") +
+        " password=" + envOr("DB_PASSWORD", "") + " host=" + envOr("DB_HOST", "localhost") +
+        " port=" + envOr("DB_PORT", "5432") + " client_encoding=UTF8";
+
+    try {
+        pqxx::connection admin(connectionString);
+
+        // 벤치마크용 사용자 준비, 종료된 방의 원래 값 보관
+        std::vector<int> users;
+        std::vector<RoomSnapshot> rooms;
+        {
+            pqxx::work txn(admin);
+            txn.exec_params(
+                "INSERT INTO users (user_name, password_hash) "
+                "SELECT 'bench_create_' || g, 'bench' FROM generate_series(1, $1) g "
+                "ON CONFLICT (user_name) DO NOTHING", kUserCount);
+            for (const auto& row : txn.exec("SELECT user_id FROM users WHERE user_name LIKE 'bench_create_%' ORDER BY user_id")) {
+                users.push_back(row[0].as<int>());
+            }
+            for (const auto& row : txn.exec(
+                "SELECT room_id, room_name, host_id, max_players FROM rooms WHERE status = 'TERMINATED' ORDER BY room_id")) {
+                rooms.push_back({ row[0].as<int>(), row[1].as<std::string>(), row[2].as<int>(), row[3].as<int>() });
+            }
+            txn.commit();
+        }
+        if (rooms.empty()) {
+            std::fprintf(stderr, "종료된 방이 없어 벤치마크를 실행할 수 없습니다\n");
+            return 1;
+        }
+
+        // 스레드마다 방을 하나씩만 점유하므로 종료된 방 수보다 많은 스레드는 빈 방을 기다리는 실패만 늘어남
+        std::printf("%zu terminated rooms, %zu users, %d cycles per user\n", rooms.size(), users.size(), kCyclesPerUser);
+        std::printf("%8s %10s %12s %10s %10s %12s %8s\n",
+            "threads", "path", "creates/s", "p50(us)", "p99(us)", "persist(ms)", "failed");
+        for (int threadCount : kThreadCounts) {
+            if (threadCount > static_cast<int>(rooms.size())) {
+                std::printf("%8d (종료된 방 수보다 많아 생략)\n", threadCount);
+                continue;
+            }
+
+            Stats legacy = benchLegacy(connectionString, users, threadCount);
+            std::printf("%8d %10s %12.0f %10.1f %10.1f %12s %8d\n",
+                threadCount, "legacy", legacy.createsPerSecond, legacy.p50Us, legacy.p99Us, "-", legacy.failed);
+
+            Stats store = benchRoomStore(connectionString, users, threadCount);
+            std::printf("%8d %10s %12.0f %10.1f %10.1f %12.1f %8d\n",
+                threadCount, "roomstore", store.createsPerSecond, store.p50Us, store.p99Us, store.persistMs, store.failed);
+        }
+
+        // 정리
+        {
+            pqxx::work txn(admin);
+            txn.exec("DELETE FROM room_users WHERE user_id IN "
+                "(SELECT user_id FROM users WHERE user_name LIKE 'bench_create_%')");
+            for (const auto& room : rooms) {
+                txn.exec_params(
+                    "UPDATE rooms SET status = 'TERMINATED', room_name = $2, host_id = $3, max_players = $4 WHERE room_id = $1",
+                    room.roomId, room.roomName, room.hostId, room.maxPlayers);
+            }
+            txn.exec("DELETE FROM users WHERE user_name LIKE 'bench_create_%'");
+            txn.commit();
+        }
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "벤치마크 오류: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
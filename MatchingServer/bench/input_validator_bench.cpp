@@ -0,0 +1,106 @@
+﻿// bench/input_validator_bench.cpp
+// 사용자 이름/닉네임/방 이름 검증 비용 벤치마크
+// 서비스에 있던 기존 검증 함수(정규식, 바이트 단위 근사 검사)와 InputValidator를 같은 입력으로 비교
+#include "util/input_validator.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace game_server;
+
+namespace {
+
+    constexpr auto kDuration = std::chrono::milliseconds(300);
+
+    // 최적화로 검증 호출이 사라지지 않도록 결과를 모아 두는 곳
+    volatile std::uint64_t g_sink = 0;
+
+    // 기존 auth_service.cpp 구현
+    bool legacyUserName(const std::string& name) {
+        if (name.empty() || name.size() > 30) return false;
+        if (name.find("mirror") != std::string::npos) return false;
+        bool isEmail = (name.find('@') != std::string::npos) &&
+            (name.find('.', name.find('@')) != std::string::npos);
+        for (unsigned char c : name) {
+            if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) continue;
+            if (isEmail && (c == '@' || c == '.' || c == '_' || c == '-' || c == '+')) continue;
+            return false;
+        }
+        return true;
+    }
+
+    bool legacyNickName(const std::string& str) {
+        if (str.size() > 24) return false;
+        std::regex pattern("^[가-힣A-Za-z0-9]+$");
+        return std::regex_match(str, pattern);
+    }
+
+    // 기존 room_service.cpp 구현
+    bool legacyRoomName(const std::string& name) {
+        if (name.empty() || name.size() > 40) return false;
+        int len = name.size();
+        for (int i = 0; i < len; ++i) {
+            const char& c = name[i];
+            if (i == len - 1 && c == '$') continue;
+            if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || (c == ' ')) continue;
+            if ((c & 0xF0) == 0xE0) continue;
+            if ((c & 0xC0) == 0x80) continue;
+            return false;
+        }
+        return true;
+    }
+
+    // 입력 목록을 정해진 시간 동안 반복 검증한 호출당 평균 시간(ns)
+    template <typename F>
+    double nsPerCall(const std::vector<std::string>& inputs, F validate) {
+        std::uint64_t calls = 0;
+        std::uint64_t accepted = 0;
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + kDuration;
+        while (std::chrono::steady_clock::now() < deadline) {
+            for (const auto& input : inputs) accepted += validate(input);
+            calls += inputs.size();
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        g_sink = g_sink + accepted;
+        return ns / calls;
+    }
+
+    template <typename Legacy, typename Current>
+    void compare(const char* label, const std::vector<std::string>& inputs, Legacy legacy, Current current) {
+        int differ = 0;
+        for (const auto& input : inputs) {
+            if (legacy(input) != current(input)) ++differ;
+        }
+        double legacyNs = nsPerCall(inputs, legacy);
+        double currentNs = nsPerCall(inputs, current);
+        std::printf("%-10s %12.1f %12.1f %8.1fx %8d/%zu\n",
+            label, legacyNs, currentNs, legacyNs / currentNs, differ, inputs.size());
+    }
+
+} // namespace
+
+int main() {
+    const std::vector<std::string> userNames = {
+        "player01", "SsafyUser2024", "someone@example.com", "a.b-c_d+e@mail.co.kr",
+        "mirror_bot", "bad name!", "", "averyveryverylongusername_over30bytes"
+    };
+    const std::vector<std::string> nickNames = {
+        "워록", "불꽃마법사", "Warlock99", "닉네임abc123", "ㄱㄴㄷ", "이름 공백", "😀emoji", "열두글자를넘는아주긴닉네임"
+    };
+    const std::vector<std::string> roomNames = {
+        "같이 하실 분", "Room 1", "초보만 오세요$", "1v1 한판", "漢字房間", "bad#room", "", "긴 방 이름을 사십 바이트보다 길게 만들어 봅니다"
+    };
+
+    std::printf("%-10s %12s %12s %9s %10s\n", "input", "legacy(ns)", "current(ns)", "speedup", "differ");
+    compare("userName", userNames, legacyUserName,
+        [](const std::string& s) { return InputValidator::isValidUserName(s); });
+    compare("nickName", nickNames, legacyNickName,
+        [](const std::string& s) { return InputValidator::isValidNickName(s); });
+    compare("roomName", roomNames, legacyRoomName,
+        [](const std::string& s) { return InputValidator::isValidRoomName(s); });
+    return 0;
+}
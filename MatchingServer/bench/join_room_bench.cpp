@@ -0,0 +1,217 @@
+﻿// bench/join_room_bench.cpp
+// 한 방에 동시에 참가할 때의 처리량/지연 시간 벤치마크
+// 기존 방식(트랜잭션 안에서 상태 확인, 중복 확인, 인원 확인 FOR UPDATE, INSERT 네 번 왕복)과
+// RoomStore 방식(메모리에서 한 번의 잠금으로 확인 후 INSERT 한 문장을 write-behind 큐로 전송)을 비교
+//
+// 서버와 같은 DB_HOST, DB_PORT, DB_USER, DB_PASSWORD, DB_NAME 환경 변수를 사용
+// 벤치마크용 사용자를 추가/삭제하고 종료된 방 하나를 잠시 사용하므로 서버를 내린 개발용 DB에서 실행
+#include "repository/room_store.h"
+#include "repository/sql_statements.h"
+#include "util/db_pool.h"
+#include "util/write_behind_queue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <pqxx/pqxx>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace game_server;
+
+namespace {
+
+    constexpr int kUserCount = 2000;
+    constexpr int kThreadCounts[] = { 1, 4, 16, 32 };
+
+    std::string envOr(const char* name, const char* fallback) {
+        const char* value = std::getenv(name);
+        return value ? value : fallback;
+    }
+
+    struct Stats {
+        double joinsPerSecond = 0;
+        double p50Us = 0;
+        double p99Us = 0;
+        double persistMs = 0;   // 마지막 참가가 DB에 반영될 때까지 걸린 시간
+    };
+
+    Stats summarize(std::vector<double>& latencies, double seconds) {
+        Stats stats;
+        std::sort(latencies.begin(), latencies.end());
+        stats.joinsPerSecond = latencies.size() / seconds;
+        stats.p50Us = latencies[latencies.size() / 2];
+        stats.p99Us = latencies[latencies.size() * 99 / 100];
+        return stats;
+    }
+
+    // 사용자들을 스레드 수만큼 나누어 동시에 참가시키고 참가마다 걸린 시간(마이크로초) 기록
+    template <typename Join>
+    double runJoins(const std::vector<int>& users, int threadCount, std::vector<double>& latencies, Join join) {
+        std::vector<std::vector<double>> perThread(threadCount);
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t]() {
+                for (std::size_t i = t; i < users.size(); i += threadCount) {
+                    auto begin = std::chrono::steady_clock::now();
+                    join(t, users[i]);
+                    perThread[t].push_back(std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now() - begin).count());
+                }
+                });
+        }
+        for (auto& thread : threads) thread.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        latencies.clear();
+        for (auto& values : perThread) latencies.insert(latencies.end(), values.begin(), values.end());
+        return seconds;
+    }
+
+    void resetRoom(pqxx::connection& conn, int roomId, int hostId) {
+        pqxx::work txn(conn);
+        txn.exec_params("DELETE FROM room_users WHERE room_id = $1", roomId);
+        txn.exec_params("UPDATE rooms SET status = 'WAITING', host_id = $2, max_players = $3 WHERE room_id = $1",
+            roomId, hostId, kUserCount);
+        txn.commit();
+    }
+
+    int countPlayers(pqxx::connection& conn, int roomId) {
+        pqxx::work txn(conn);
+        auto result = txn.exec_params("SELECT COUNT(*) FROM room_users WHERE room_id = $1", roomId);
+        txn.commit();
+        return result[0][0].as<int>();
+    }
+
+    // 기존 RoomRepositoryImpl::addPlayer와 같은 네 번의 왕복
+    bool legacyJoin(pqxx::connection& conn, int roomId, int userId) {
+        pqxx::work txn(conn);
+        auto roomCheck = txn.exec_params("SELECT status FROM rooms WHERE room_id = $1", roomId);
+        if (roomCheck.empty() || roomCheck[0][0].as<std::string>() != "WAITING") return false;
+
+        auto checkResult = txn.exec_params(
+            "SELECT joined_at FROM room_users WHERE room_id = $1 AND user_id = $2", roomId, userId);
+        if (!checkResult.empty()) return false;
+
+        auto maxPlayersResult = txn.exec_params(
+            "SELECT max_players, "
+            "(SELECT COUNT(*) FROM room_users WHERE room_id = $1) as current_players "
+            "FROM rooms WHERE room_id = $1 FOR UPDATE", roomId);
+        if (maxPlayersResult[0]["current_players"].as<int>() >= maxPlayersResult[0]["max_players"].as<int>()) return false;
+
+        txn.exec_params("INSERT INTO room_users (room_id, user_id, joined_at) VALUES ($1, $2, DEFAULT) RETURNING room_id",
+            roomId, userId);
+        txn.commit();
+        return true;
+    }
+
+    Stats benchLegacy(const std::string& connectionString, pqxx::connection& admin,
+        int roomId, const std::vector<int>& users, int threadCount) {
+        resetRoom(admin, roomId, users.front());
+
+        std::vector<std::unique_ptr<pqxx::connection>> conns;
+        for (int t = 0; t < threadCount; ++t) {
+            conns.push_back(std::make_unique<pqxx::connection>(connectionString));
+        }
+
+        std::vector<double> latencies;
+        double seconds = runJoins(users, threadCount, latencies, [&](int t, int userId) {
+            legacyJoin(*conns[t], roomId, userId);
+            });
+        return summarize(latencies, seconds);
+    }
+
+    Stats benchRoomStore(const std::string& connectionString, pqxx::connection& admin,
+        int roomId, const std::vector<int>& users, int threadCount) {
+        resetRoom(admin, roomId, users.front());
+
+        DbPool pool(connectionString, 2, std::chrono::milliseconds(3000), prepareStatements);
+        WriteBehindQueue writeBehind(connectionString, statementCatalog());
+        RoomStore store(&pool, &writeBehind);
+        store.load();
+
+        std::vector<double> latencies;
+        double seconds = runJoins(users, threadCount, latencies, [&](int, int userId) {
+            store.addPlayer(roomId, userId);
+            });
+        Stats stats = summarize(latencies, seconds);
+
+        // 큐에 쌓인 INSERT가 모두 반영될 때까지의 시간
+        auto flushStart = std::chrono::steady_clock::now();
+        writeBehind.stop();
+        stats.persistMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - flushStart).count();
+        return stats;
+    }
+
+} // namespace
+
+int main() {
+    spdlog::set_level(spdlog::level::warn);
+
+    std::string connectionString =
+        "dbname=" + envOr("DB_NAME", "postgres") + " user=" + envOr("DB_USER", "postgres") +
+        " password=" + envOr("DB_PASSWORD", "") + " host=" + envOr("DB_HOST", "localhost") +
+        " port=" + envOr("DB_PORT", "5432") + " client_encoding=UTF8";
+
+    try {
+        pqxx::connection admin(connectionString);
+
+        // 벤치마크용 사용자와 방 준비
+        std::vector<int> users;
+        int roomId = 0;
+        int originalHostId = 0;
+        int originalMaxPlayers = 0;
+        {
+            pqxx::work txn(admin);
+            txn.exec_params(
+                "INSERT INTO users (user_name, password_hash) "
+                "SELECT 'bench_join_' || g, 'bench' FROM generate_series(1, $1) g "
+                "ON CONFLICT (user_name) DO NOTHING", kUserCount);
+            for (const auto& row : txn.exec("SELECT user_id FROM users WHERE user_name LIKE 'bench_join_%' ORDER BY user_id")) {
+                users.push_back(row[0].as<int>());
+            }
+            auto room = txn.exec("SELECT room_id, host_id, max_players FROM rooms WHERE status = 'TERMINATED' ORDER BY room_id LIMIT 1");
+            if (room.empty()) {
+                std::fprintf(stderr, "종료된 방이 없어 벤치마크를 실행할 수 없습니다\n");
+                return 1;
+            }
+            roomId = room[0][0].as<int>();
+            originalHostId = room[0][1].as<int>();
+            originalMaxPlayers = room[0][2].as<int>();
+            txn.commit();
+        }
+
+        std::printf("room %d, %zu users\n", roomId, users.size());
+        std::printf("%8s %10s %12s %10s %10s %12s\n", "threads", "path", "joins/s", "p50(us)", "p99(us)", "persist(ms)");
+        for (int threadCount : kThreadCounts) {
+            Stats legacy = benchLegacy(connectionString, admin, roomId, users, threadCount);
+            int legacyJoined = countPlayers(admin, roomId);
+            std::printf("%8d %10s %12.0f %10.1f %10.1f %12s  (%d joined)\n",
+                threadCount, "legacy", legacy.joinsPerSecond, legacy.p50Us, legacy.p99Us, "-", legacyJoined);
+
+            Stats store = benchRoomStore(connectionString, admin, roomId, users, threadCount);
+            int storeJoined = countPlayers(admin, roomId);
+            std::printf("%8d %10s %12.0f %10.1f %10.1f %12.1f  (%d joined)\n",
+                threadCount, "roomstore", store.joinsPerSecond, store.p50Us, store.p99Us, store.persistMs, storeJoined);
+        }
+
+        // 정리
+        {
+            pqxx::work txn(admin);
+            txn.exec_params("DELETE FROM room_users WHERE room_id = $1", roomId);
+            txn.exec_params("UPDATE rooms SET status = 'TERMINATED', host_id = $2, max_players = $3 WHERE room_id = $1",
+                roomId, originalHostId, originalMaxPlayers);
+            txn.exec("DELETE FROM users WHERE user_name LIKE 'bench_join_%'");
+            txn.commit();
+        }
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "벤치마크 오류: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+﻿// bench/password_hash_bench.cpp
+// 비밀번호 해싱/검증 처리량 벤치마크
+// 1) 한 스레드에서 기존 구현(stringstream 16진수 변환, 일반 문자열 비교)과 현재 PasswordUtil 비교
+// 2) PasswordHasher 스레드 수별 초당 검증 수와 스레드(코어)당 처리량
+#include "util/password_hasher.h"
+#include "util/password_util.h"
+#include <openssl/sha.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <iomanip>
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace game_server;
+
+namespace {
+
+    constexpr auto kDuration = std::chrono::milliseconds(500);
+    constexpr int kBatch = 4096;    // PasswordHasher에 한 번에 넣는 검증 요청 수
+
+    // 기존 PasswordUtil 구현
+    std::string legacyHash(const std::string& password) {
+        unsigned char hash[SHA256_DIGEST_LENGTH];
+        SHA256(reinterpret_cast<const unsigned char*>(password.c_str()), password.length(), hash);
+        std::stringstream ss;
+        for (int i = 0; i < SHA256_DIGEST_LENGTH; i++) {
+            ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(hash[i]);
+        }
+        return ss.str();
+    }
+
+    bool legacyVerify(const std::string& password, const std::string& hashedPassword) {
+        return legacyHash(password) == hashedPassword;
+    }
+
+    // 정해진 시간 동안 반복 실행한 초당 횟수
+    template <typename F>
+    double opsPerSecond(F op) {
+        std::uint64_t count = 0;
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + kDuration;
+        while (std::chrono::steady_clock::now() < deadline) {
+            for (int i = 0; i < 256; ++i) op();
+            count += 256;
+        }
+        return count / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double hasherVerifiesPerSecond(int threads, const std::string& password, const std::string& hashed) {
+        PasswordHasher hasher(threads, kBatch);
+        std::uint64_t count = 0;
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + kDuration;
+        std::vector<std::future<bool>> futures;
+        futures.reserve(kBatch);
+        while (std::chrono::steady_clock::now() < deadline) {
+            futures.clear();
+            for (int i = 0; i < kBatch; ++i) futures.push_back(hasher.verifyAsync(password, hashed));
+            for (auto& future : futures) {
+                if (!future.get()) std::abort();
+            }
+            count += kBatch;
+        }
+        return count / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+} // namespace
+
+int main() {
+    spdlog::set_level(spdlog::level::warn);
+
+    const std::string password = "correct horse battery staple";
+    const std::string hashed = PasswordUtil::hashPassword(password);
+    if (hashed != legacyHash(password)) {
+        std::fprintf(stderr, "해시 결과가 기존 구현과 다릅니다\n");
+        return 1;
+    }
+
+    std::printf("단일 스레드 (초당 횟수)\n");
+    std::printf("%-10s %14s %14s %8s\n", "op", "legacy", "current", "ratio");
+    double legacyHashOps = opsPerSecond([&]() { legacyHash(password); });
+    double hashOps = opsPerSecond([&]() { PasswordUtil::hashPassword(password); });
+    std::printf("%-10s %14.0f %14.0f %7.2fx\n", "hash", legacyHashOps, hashOps, hashOps / legacyHashOps);
+    double legacyVerifyOps = opsPerSecond([&]() { legacyVerify(password, hashed); });
+    double verifyOps = opsPerSecond([&]() { PasswordUtil::verifyPassword(password, hashed); });
+    std::printf("%-10s %14.0f %14.0f %7.2fx\n", "verify", legacyVerifyOps, verifyOps, verifyOps / legacyVerifyOps);
+
+    std::printf("\nPasswordHasher 검증 처리량\n");
+    std::printf("%8s %14s %16s\n", "threads", "verifies/s", "per thread/s");
+    int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double ops = hasherVerifiesPerSecond(threads, password, hashed);
+        std::printf("%8d %14.0f %16.0f\n", threads, ops, ops / threads);
+    }
+    return 0;
+}
@@ -1,5 +1,7 @@
 ﻿// controller/controller.h
 #pragma once
+#include "../core/wire_codec.h"
+#include <memory>
 #include <string>
 #include <nlohmann/json.hpp>
 
@@ -10,6 +12,11 @@ namespace game_server {
         virtual ~Controller() = default;
 
         virtual nlohmann::json handleRequest(nlohmann::json& request) = 0;
+
+        // 미리 인코딩해 둔 응답을 그대로 보낼 수 있는 요청이면 그 응답 반환 (nullptr이면 handleRequest로 처리)
+        virtual std::shared_ptr<const EncodedMessage> handleCachedRequest(nlohmann::json& /*request*/) {
+            return nullptr;
+        }
     };
 
 } // namespace game_server
@@ -38,6 +38,14 @@ namespace game_server {
         }
     }
 
+    std::shared_ptr<const EncodedMessage> RoomController::handleCachedRequest(json& request) {
+        // 방 목록은 방 목록 버전별로 인코딩해 둔 응답을 모든 세션이 공유
+        if (request["action"] == "listRooms") {
+            return roomService_->listRoomsEncoded();
+        }
+        return nullptr;
+    }
+
     nlohmann::json RoomController::handleCreateRoom(json& request) {
         json response = roomService_->createRoom(request);
         return response;
@@ -12,6 +12,7 @@ namespace game_server {
         ~RoomController() override = default;
 
         nlohmann::json handleRequest(nlohmann::json& request) override;
+        std::shared_ptr<const EncodedMessage> handleCachedRequest(nlohmann::json& request) override;
 
     private:
         nlohmann::json handleCreateRoom(nlohmann::json& request);
@@ -0,0 +1,130 @@
+﻿// core/connection_limiter.cpp
+// IP별 접속 제한기 구현 파일
+// 토큰은 조회 시점에 지난 시간만큼 채우므로 별도의 충전 타이머가 필요 없음
+#include "connection_limiter.h"
+#include <algorithm>
+#include <functional>
+
+namespace game_server {
+
+    void ConnectionLimiter::TokenBucket::refill(double rate, double burst, clock::time_point now) {
+        double elapsed = std::chrono::duration<double>(now - refilled).count();
+        tokens = std::min(burst, tokens + elapsed * rate);
+        refilled = now;
+    }
+
+    bool ConnectionLimiter::TokenBucket::take(double rate, double burst, clock::time_point now) {
+        if (rate <= 0) return true;
+        refill(rate, burst, now);
+        if (tokens < 1.0) return false;
+        tokens -= 1.0;
+        return true;
+    }
+
+    ConnectionLimiter::ConnectionLimiter(Config config)
+        : config_(config)
+    {
+    }
+
+    bool ConnectionLimiter::allowAccept(const std::string& ip) {
+        if (config_.connectRate <= 0) {
+            ++accepted_;
+            return true;
+        }
+
+        auto now = clock::now();
+        auto& shard = shardFor(ip);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto& entry = entryFor(shard, ip, now);
+            if (!entry.connect.take(config_.connectRate, config_.connectBurst, now)) {
+                ++connect_limited_;
+                return false;
+            }
+        }
+        ++accepted_;
+        return true;
+    }
+
+    ConnectionLimiter::Admission ConnectionLimiter::allowSession(const std::string& ip) {
+        auto now = clock::now();
+        auto& shard = shardFor(ip);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto& entry = entryFor(shard, ip, now);
+
+        if (config_.maxConnectionsPerIp > 0 && entry.active >= config_.maxConnectionsPerIp) {
+            ++concurrent_limited_;
+            return Admission::TooManyConnections;
+        }
+        if (!entry.handshake.take(config_.handshakeRate, config_.handshakeBurst, now)) {
+            ++handshake_limited_;
+            return Admission::RateLimited;
+        }
+
+        ++entry.active;
+        ++active_;
+        return Admission::Allowed;
+    }
+
+    void ConnectionLimiter::release(const std::string& ip) {
+        auto& shard = shardFor(ip);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.map.find(ip);
+        if (it == shard.map.end() || it->second.active <= 0) return;
+        --it->second.active;
+        --active_;
+    }
+
+    std::size_t ConnectionLimiter::sweep() {
+        auto now = clock::now();
+        std::size_t removed = 0;
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (auto it = shard.map.begin(); it != shard.map.end();) {
+                auto& entry = it->second;
+                entry.connect.refill(config_.connectRate, config_.connectBurst, now);
+                entry.handshake.refill(config_.handshakeRate, config_.handshakeBurst, now);
+                // 토큰이 덜 채워진 항목을 지우면 다음 연결에서 가득 찬 버킷으로 다시 시작하므로 남겨 둠
+                bool idle = entry.active == 0 &&
+                    (config_.connectRate <= 0 || entry.connect.tokens >= config_.connectBurst) &&
+                    (config_.handshakeRate <= 0 || entry.handshake.tokens >= config_.handshakeBurst);
+                if (idle) {
+                    it = shard.map.erase(it);
+                    ++removed;
+                }
+                else {
+                    ++it;
+                }
+            }
+        }
+        tracked_ -= removed;
+        return removed;
+    }
+
+    ConnectionLimiter::Metrics ConnectionLimiter::getMetrics() const {
+        return Metrics{
+            tracked_.load(),
+            active_.load(),
+            accepted_.load(),
+            connect_limited_.load(),
+            handshake_limited_.load(),
+            concurrent_limited_.load()
+        };
+    }
+
+    ConnectionLimiter::Shard& ConnectionLimiter::shardFor(const std::string& ip) {
+        return shards_[std::hash<std::string>{}(ip) % kShardCount];
+    }
+
+    ConnectionLimiter::Entry& ConnectionLimiter::entryFor(Shard& shard, const std::string& ip, clock::time_point now) {
+        auto [it, inserted] = shard.map.try_emplace(ip);
+        if (inserted) {
+            // 새 IP는 버킷이 가득 찬 상태에서 시작
+            it->second.connect = TokenBucket{ config_.connectBurst, now };
+            it->second.handshake = TokenBucket{ config_.handshakeBurst, now };
+            ++tracked_;
+        }
+        return it->second;
+    }
+
+} // namespace game_server
@@ -0,0 +1,93 @@
+﻿// core/connection_limiter.h
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace game_server {
+
+    // IP별 동시 접속 수와 접속/핸드셰이크 빈도를 제한하는 접속 제한기
+    // IP 테이블은 샤드 단위로 나눠 잠그며, 집계는 원자적 카운터로 유지해 접속이 몰려도 판정 비용이 일정함
+    class ConnectionLimiter {
+    public:
+        static constexpr std::size_t kShardCount = 16;
+        using clock = std::chrono::steady_clock;
+
+        struct Config {
+            int maxConnectionsPerIp = 4;    // IP별 최대 동시 접속 수 (0이면 제한 없음)
+            double connectRate = 5.0;       // IP별 초당 새 연결 허용 수 (0이면 제한 없음)
+            double connectBurst = 10.0;     // 연속으로 허용하는 최대 새 연결 수
+            double handshakeRate = 2.0;     // IP별 초당 핸드셰이크 허용 수 (0이면 제한 없음)
+            double handshakeBurst = 5.0;    // 연속으로 허용하는 최대 핸드셰이크 수
+        };
+
+        enum class Admission {
+            Allowed,
+            RateLimited,        // 핸드셰이크 빈도 초과
+            TooManyConnections  // 동시 접속 수 초과
+        };
+
+        struct Metrics {
+            std::size_t trackedIps;
+            std::uint64_t activeConnections;
+            std::uint64_t accepted;
+            std::uint64_t connectRateLimited;
+            std::uint64_t handshakeRateLimited;
+            std::uint64_t concurrentLimited;
+        };
+
+        explicit ConnectionLimiter(Config config);
+
+        // 연결 수락 직후 새 연결 빈도 확인 (거절 시 핸드셰이크 전에 바로 닫음)
+        bool allowAccept(const std::string& ip);
+
+        // 클라이언트 핸드셰이크 시 핸드셰이크 빈도와 동시 접속 수 확인, 허용되면 동시 접속 수 증가
+        Admission allowSession(const std::string& ip);
+
+        // 허용된 세션 종료 시 동시 접속 수 감소
+        void release(const std::string& ip);
+
+        // 접속 중인 세션이 없고 토큰이 모두 채워진 IP 항목 정리, 정리한 항목 수 반환
+        std::size_t sweep();
+
+        const Config& config() const { return config_; }
+        Metrics getMetrics() const;
+
+    private:
+        struct TokenBucket {
+            double tokens;
+            clock::time_point refilled;
+
+            void refill(double rate, double burst, clock::time_point now);
+            bool take(double rate, double burst, clock::time_point now);
+        };
+
+        struct Entry {
+            int active = 0;
+            TokenBucket connect;
+            TokenBucket handshake;
+        };
+
+        struct Shard {
+            mutable std::mutex mutex;
+            std::unordered_map<std::string, Entry> map;
+        };
+
+        Shard& shardFor(const std::string& ip);
+        Entry& entryFor(Shard& shard, const std::string& ip, clock::time_point now);
+
+        const Config config_;
+        std::array<Shard, kShardCount> shards_;
+        std::atomic<std::size_t> tracked_{ 0 };
+        std::atomic<std::uint64_t> active_{ 0 };
+        std::atomic<std::uint64_t> accepted_{ 0 };
+        std::atomic<std::uint64_t> connect_limited_{ 0 };
+        std::atomic<std::uint64_t> handshake_limited_{ 0 };
+        std::atomic<std::uint64_t> concurrent_limited_{ 0 };
+    };
+
+} // namespace game_server
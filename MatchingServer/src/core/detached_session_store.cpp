@@ -0,0 +1,90 @@
+﻿// core/detached_session_store.cpp
+// 재개 대기 세션 저장소 구현 파일
+#include "detached_session_store.h"
+
+namespace game_server {
+
+    void DetachedSessionStore::add(const std::string& token, State state, clock::time_point deadline) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto user = token_by_user_.find(state.userId);
+        if (user != token_by_user_.end() && user->second != token) {
+            by_token_.erase(user->second);
+        }
+        token_by_user_[state.userId] = token;
+        by_token_[token] = Entry{ std::move(state), deadline };
+    }
+
+    std::optional<DetachedSessionStore::State> DetachedSessionStore::take(const std::string& token) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto state = eraseLocked(token);
+        if (state) ++resumed_;
+        return state;
+    }
+
+    std::optional<DetachedSessionStore::State> DetachedSessionStore::takeUser(int userId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto user = token_by_user_.find(userId);
+        if (user == token_by_user_.end()) return std::nullopt;
+        auto state = eraseLocked(std::string(user->second));
+        if (state) ++taken_over_;
+        return state;
+    }
+
+    bool DetachedSessionStore::containsUser(int userId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return token_by_user_.count(userId) > 0;
+    }
+
+    void DetachedSessionStore::updateStatus(int userId, const std::string& status) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto user = token_by_user_.find(userId);
+        if (user == token_by_user_.end()) return;
+        auto it = by_token_.find(user->second);
+        if (it != by_token_.end()) {
+            it->second.state.status = status;
+        }
+    }
+
+    std::vector<DetachedSessionStore::State> DetachedSessionStore::takeExpired(clock::time_point now) {
+        std::vector<State> expired;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = by_token_.begin(); it != by_token_.end();) {
+            if (it->second.deadline > now) {
+                ++it;
+                continue;
+            }
+            token_by_user_.erase(it->second.state.userId);
+            expired.push_back(std::move(it->second.state));
+            it = by_token_.erase(it);
+        }
+        expired_ += expired.size();
+        return expired;
+    }
+
+    std::vector<DetachedSessionStore::State> DetachedSessionStore::clear() {
+        std::vector<State> states;
+        std::lock_guard<std::mutex> lock(mutex_);
+        states.reserve(by_token_.size());
+        for (auto& [token, entry] : by_token_) {
+            states.push_back(std::move(entry.state));
+        }
+        by_token_.clear();
+        token_by_user_.clear();
+        return states;
+    }
+
+    DetachedSessionStore::Metrics DetachedSessionStore::getMetrics() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return Metrics{ by_token_.size(), resumed_, expired_, taken_over_ };
+    }
+
+    std::optional<DetachedSessionStore::State> DetachedSessionStore::eraseLocked(const std::string& token) {
+        auto it = by_token_.find(token);
+        if (it == by_token_.end()) return std::nullopt;
+        State state = std::move(it->second.state);
+        by_token_.erase(it);
+        token_by_user_.erase(state.userId);
+        return state;
+    }
+
+} // namespace game_server
@@ -0,0 +1,71 @@
+﻿// core/detached_session_store.h
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace game_server {
+
+    // 연결이 끊긴 로그인 세션의 상태를 재개 유예 시간 동안 보관하는 저장소
+    // 같은 세션 토큰으로 다시 접속한 클라이언트는 재인증 없이 보관된 상태를 이어받음
+    class DetachedSessionStore {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        struct State {
+            int userId = 0;
+            std::string userName;
+            std::string nickName;
+            std::string status;
+        };
+
+        struct Metrics {
+            std::size_t detached;      // 현재 재개를 기다리는 세션 수
+            std::uint64_t resumed;     // 재개에 성공한 세션 수
+            std::uint64_t expired;     // 유예 시간이 지나 정리된 세션 수
+            std::uint64_t takenOver;   // 유예 중 새 로그인으로 정리된 세션 수
+        };
+
+        // 토큰으로 상태 보관 (같은 유저의 이전 항목은 교체)
+        void add(const std::string& token, State state, clock::time_point deadline);
+
+        // 토큰에 해당하는 상태를 꺼냄 (재개)
+        std::optional<State> take(const std::string& token);
+
+        // 유저의 상태를 꺼냄 (같은 유저가 재개 대신 새로 로그인한 경우)
+        std::optional<State> takeUser(int userId);
+
+        bool containsUser(int userId);
+
+        // 유예 중 게임 종료 등으로 바뀐 상태 반영
+        void updateStatus(int userId, const std::string& status);
+
+        // 유예 시간이 지난 상태를 모두 꺼냄
+        std::vector<State> takeExpired(clock::time_point now);
+
+        // 모든 상태를 꺼냄 (서버 종료)
+        std::vector<State> clear();
+
+        Metrics getMetrics();
+
+    private:
+        struct Entry {
+            State state;
+            clock::time_point deadline;
+        };
+
+        std::optional<State> eraseLocked(const std::string& token);
+
+        std::mutex mutex_;
+        std::unordered_map<std::string, Entry> by_token_;
+        std::unordered_map<int, std::string> token_by_user_;
+        std::uint64_t resumed_ = 0;
+        std::uint64_t expired_ = 0;
+        std::uint64_t taken_over_ = 0;
+    };
+
+} // namespace game_server
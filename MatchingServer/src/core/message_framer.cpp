@@ -0,0 +1,124 @@
+﻿// core/message_framer.cpp
+// 메시지 프레이머 구현 파일
+// 누적 버퍼에서 완성된 JSON 프레임 또는 길이 접두사 프레임을 찾아 분리
+#include "message_framer.h"
+#include <cstdint>
+
+namespace game_server {
+
+    bool MessageFramer::append(const char* data, std::size_t length) {
+        if (buffer_.size() - consumed_ + length > kMaxFrameSize) {
+            return false;
+        }
+        buffer_.append(data, length);
+        return true;
+    }
+
+    bool MessageFramer::next(std::string& frame) {
+        if (length_prefixed_) {
+            return nextLengthPrefixed(frame);
+        }
+
+        while (scan_pos_ < buffer_.size()) {
+            char c = buffer_[scan_pos_];
+
+            if (depth_ == 0) {
+                // 프레임 사이의 공백과 개행 구분자는 건너뜀
+                if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+                    consumed_ = ++scan_pos_;
+                    continue;
+                }
+
+                if (c == '{' || c == '[') {
+                    frame_start_ = scan_pos_++;
+                    depth_ = 1;
+                    continue;
+                }
+
+                // JSON이 아닌 데이터는 개행까지를 하나의 프레임으로 넘겨 파싱 오류로 처리되게 함
+                std::size_t eol = buffer_.find('\n', scan_pos_);
+                if (eol == std::string::npos) {
+                    break;
+                }
+                frame.assign(buffer_, scan_pos_, eol - scan_pos_);
+                consumed_ = scan_pos_ = eol + 1;
+                return true;
+            }
+
+            ++scan_pos_;
+            if (in_string_) {
+                if (escaped_) escaped_ = false;
+                else if (c == '\\') escaped_ = true;
+                else if (c == '"') in_string_ = false;
+                continue;
+            }
+
+            if (c == '"') {
+                in_string_ = true;
+            }
+            else if (c == '{' || c == '[') {
+                ++depth_;
+            }
+            else if ((c == '}' || c == ']') && --depth_ == 0) {
+                frame.assign(buffer_, frame_start_, scan_pos_ - frame_start_);
+                consumed_ = scan_pos_;
+                return true;
+            }
+        }
+
+        compact();
+        return false;
+    }
+
+    void MessageFramer::setLengthPrefixed() {
+        length_prefixed_ = true;
+        skip_delimiter_ = true;
+        scan_pos_ = consumed_;
+        depth_ = 0;
+        in_string_ = false;
+        escaped_ = false;
+    }
+
+    bool MessageFramer::nextLengthPrefixed(std::string& frame) {
+        // 핸드셰이크 JSON 뒤의 개행 구분자는 다음 읽기에서 도착할 수도 있으므로 첫 바이너리 프레임 전까지 건너뜀
+        // 길이는 최대 프레임 크기보다 작아 첫 바이트가 항상 0이므로 공백 문자와 겹치지 않음
+        while (skip_delimiter_ && consumed_ < buffer_.size()) {
+            char c = buffer_[consumed_];
+            if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+                skip_delimiter_ = false;
+                break;
+            }
+            ++consumed_;
+        }
+        scan_pos_ = consumed_;
+
+        std::size_t available = buffer_.size() - consumed_;
+        if (available >= 4) {
+            const auto* header = reinterpret_cast<const unsigned char*>(buffer_.data() + consumed_);
+            std::size_t length = (static_cast<std::uint32_t>(header[0]) << 24) |
+                (static_cast<std::uint32_t>(header[1]) << 16) |
+                (static_cast<std::uint32_t>(header[2]) << 8) |
+                static_cast<std::uint32_t>(header[3]);
+
+            if (available - 4 >= length) {
+                frame.assign(buffer_, consumed_ + 4, length);
+                consumed_ += 4 + length;
+                scan_pos_ = consumed_;
+                return true;
+            }
+        }
+
+        // 최대 크기를 넘는 길이는 append()가 누적 한도에서 거절
+        compact();
+        return false;
+    }
+
+    void MessageFramer::compact() {
+        if (consumed_ == 0) return;
+        buffer_.erase(0, consumed_);
+        scan_pos_ -= consumed_;
+        if (depth_ > 0) frame_start_ -= consumed_;
+        consumed_ = 0;
+    }
+
+} // namespace game_server
@@ -0,0 +1,41 @@
+﻿// core/message_framer.h
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace game_server {
+
+    // TCP 스트림을 메시지(프레임) 단위로 나누는 프레이머
+    // 수신 데이터를 누적한 뒤 완성된 최상위 JSON 값만 프레임으로 꺼냄
+    // 개행 구분 클라이언트와 구분자 없이 JSON을 이어 보내는 기존 클라이언트를 모두 지원
+    // 바이너리 인코딩이 협상된 뒤에는 4바이트 빅엔디안 길이 접두사 프레임으로 전환
+    class MessageFramer {
+    public:
+        // 완성되지 않은 한 프레임이 차지할 수 있는 최대 크기
+        static constexpr std::size_t kMaxFrameSize = 64 * 1024;
+
+        // 수신 데이터 누적, 미완성 프레임이 최대 크기를 넘으면 false
+        bool append(const char* data, std::size_t length);
+
+        // 완성된 프레임이 있으면 frame에 담고 true, 더 읽어야 하면 false
+        bool next(std::string& frame);
+
+        // 이후 수신 데이터를 길이 접두사 프레임으로 해석 (프레임 경계에서만 호출)
+        void setLengthPrefixed();
+
+    private:
+        bool nextLengthPrefixed(std::string& frame);
+        void compact();
+
+        std::string buffer_;
+        std::size_t scan_pos_ = 0;     // 다음에 검사할 위치
+        std::size_t consumed_ = 0;     // 프레임으로 꺼내간 위치
+        std::size_t frame_start_ = 0;  // 현재 프레임 시작 위치
+        int depth_ = 0;                // 괄호 중첩 깊이
+        bool in_string_ = false;
+        bool escaped_ = false;
+        bool length_prefixed_ = false;
+        bool skip_delimiter_ = false;  // 전환 직전 JSON 프레임 뒤의 공백/개행 구분자를 아직 건너뛰는 중인지 여부
+    };
+
+} // namespace game_server
@@ -0,0 +1,80 @@
+﻿// core/presence_tracker.cpp
+// 접속자 목록 관리 구현 파일
+// 변경 사항을 유저 단위로 합쳐 두었다가 브로드캐스트 주기마다 한 번에 발행
+#include "presence_tracker.h"
+
+namespace game_server {
+
+    using json = nlohmann::json;
+
+    void PresenceTracker::update(int userId, const std::string& nickName, const std::string& status) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = users_.find(userId);
+        if (it != users_.end() && it->second.nickName == nickName && it->second.status == status) {
+            return;
+        }
+        Entry entry{ nickName, status };
+        users_[userId] = entry;
+        pending_[userId] = std::move(entry);
+    }
+
+    void PresenceTracker::remove(int userId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (users_.erase(userId) == 0) return;
+        pending_[userId] = std::nullopt;
+    }
+
+    json PresenceTracker::snapshot() const {
+        json users = json::array();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [userId, entry] : users_) {
+            users.push_back({
+                {"userId", userId},
+                {"nickName", entry.nickName},
+                {"status", entry.status}
+            });
+        }
+        // 스냅샷에는 아직 발행되지 않은 변경도 포함되지만, 델타 적용이 멱등이므로 다음 버전 델타와 충돌하지 않음
+        return {
+            {"action", "CCUList"},
+            {"version", version_},
+            {"users", std::move(users)}
+        };
+    }
+
+    json PresenceTracker::flushDelta() {
+        json changes = json::array();
+        std::uint64_t version;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (pending_.empty()) return nullptr;
+
+            for (const auto& [userId, entry] : pending_) {
+                if (entry) {
+                    changes.push_back({
+                        {"op", "update"},
+                        {"userId", userId},
+                        {"nickName", entry->nickName},
+                        {"status", entry->status}
+                    });
+                }
+                else {
+                    changes.push_back({
+                        {"op", "remove"},
+                        {"userId", userId}
+                    });
+                }
+            }
+            pending_.clear();
+            version = ++version_;
+        }
+
+        return {
+            {"action", "CCUDelta"},
+            {"version", version},
+            {"prevVersion", version - 1},
+            {"changes", std::move(changes)}
+        };
+    }
+
+} // namespace game_server
@@ -0,0 +1,41 @@
+﻿// core/presence_tracker.h
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+
+    // 로비 접속자 목록(닉네임/상태)을 버전 단위로 관리
+    // 대기실에 들어온 클라이언트는 전체 목록(CCUList)을 한 번 받고,
+    // 이후에는 브로드캐스트 주기마다 묶인 변경 사항(CCUDelta)만 받음
+    class PresenceTracker {
+    public:
+        // 접속자 추가 또는 닉네임/상태 변경
+        void update(int userId, const std::string& nickName, const std::string& status);
+
+        // 접속자 제거
+        void remove(int userId);
+
+        // 현재 버전의 전체 목록
+        nlohmann::json snapshot() const;
+
+        // 지난 호출 이후 변경 사항을 새 버전으로 발행, 변경이 없으면 null 반환
+        nlohmann::json flushDelta();
+
+    private:
+        struct Entry {
+            std::string nickName;
+            std::string status;
+        };
+
+        mutable std::mutex mutex_;
+        std::unordered_map<int, Entry> users_;
+        std::unordered_map<int, std::optional<Entry>> pending_; // 값이 없으면 제거
+        std::uint64_t version_ = 0;
+    };
+
+} // namespace game_server
@@ -10,6 +10,9 @@
 #include "../repository/user_repository.h"
 #include "../repository/room_repository.h"
 #include "../repository/game_repository.h"
+#include "../repository/sql_statements.h"
+#include "../repository/room_store.h"
+#include "../util/query_stats.h"
 #include <iostream>
 #include <spdlog/spdlog.h>
 #include <boost/uuid/uuid.hpp>
@@ -26,17 +29,57 @@ namespace game_server {
     Server::Server(boost::asio::io_context& io_context,
         short port,
         const std::string& db_connection_string,
-        const std::string& version)
+        const std::string& version,
+        int worker_threads,
+        std::size_t worker_queue_limit,
+        int db_pool_size,
+        std::chrono::milliseconds db_acquire_timeout,
+        const std::string& db_replica_connection_string,
+        int db_replica_pool_size,
+        bool db_replica_fallback,
+        std::size_t user_cache_size,
+        int hash_threads,
+        std::size_t hash_queue_limit,
+        const ConnectionLimiter::Config& connection_limits)
         : io_context_(io_context),
+        strand_(boost::asio::make_strand(io_context)),
         acceptor_(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port)),
+        user_cache_size_(user_cache_size),
         running_(false),
+        connection_limiter_(connection_limits),
         uuid_generator_(),
-        session_check_timer_(io_context),
-        broadcast_timer_(io_context),
+        resume_sweep_timer_(strand_),
+        broadcast_timer_(strand_),
+        metrics_timer_(strand_),
+        last_login_timer_(strand_),
+        limiter_sweep_timer_(strand_),
         version_(version)
     {
-        // DB풀 생성
-        db_pool_ = std::make_unique<DbPool>(db_connection_string, 20);
+        // DB풀 생성 (풀 크기를 넘는 연결은 만들지 않고 대기, 연결마다 prepared statement 등록)
+        db_pool_ = std::make_unique<DbPool>(db_connection_string, db_pool_size, db_acquire_timeout, prepareStatements);
+
+        // 읽기 전용 복제본 풀 생성 (설정된 경우, 대체 허용 시 복제본 연결 실패는 기본 DB만으로 계속 실행)
+        if (!db_replica_connection_string.empty()) {
+            try {
+                db_pool_->setReplica(std::make_unique<DbPool>(db_replica_connection_string, db_replica_pool_size,
+                    db_acquire_timeout, prepareStatements), db_replica_fallback);
+                spdlog::info("읽기 전용 DB 복제본 풀 연결 완료, 기본 DB 대체 : {}", db_replica_fallback);
+            }
+            catch (const std::exception& e) {
+                if (!db_replica_fallback) throw;
+                spdlog::error("읽기 전용 DB 복제본에 연결하지 못해 기본 DB만 사용합니다: {}", e.what());
+            }
+        }
+
+        // 메모리 방 상태를 DB에 순서대로 반영할 write-behind 큐 생성 (전용 비동기 연결 사용)
+        write_behind_ = std::make_unique<WriteBehindQueue>(db_connection_string, statementCatalog());
+        last_login_ = std::make_unique<LastLoginBuffer>(write_behind_.get());
+
+        // 비밀번호 해싱 전용 풀 생성 (로그인이 몰려도 해싱에 쓰는 CPU 코어 수 제한)
+        password_hasher_ = std::make_unique<PasswordHasher>(hash_threads, hash_queue_limit);
+
+        // 컨트롤러 작업을 처리할 워커 풀 생성
+        worker_pool_ = std::make_unique<WorkerPool>(worker_threads, worker_queue_limit);
 
         // 컨트롤러 초기화
         init_controllers();
@@ -52,23 +95,15 @@ namespace game_server {
     }
 
     void Server::setSessionStatus(const json& users, bool flag) {
-        std::vector<std::string> tokens;
-        {
-            std::lock_guard<std::mutex> tokens_lock(tokens_mutex_);
-            for (const auto& user : users["users"]) {
-                int u = user.get<int>();
-                if (!tokens_.count(u)) continue;
-                tokens.push_back(tokens_[u]);
-            }
-        }
-        {
-            std::lock_guard<std::mutex> sesions_lock(sessions_mutex_);
-            for (const std::string& token : tokens) {
-                if (!sessions_.count(token)) continue;
-                auto session = sessions_[token].lock();
-                if (flag) session->setStatus("게임중");
-                else session->setStatus("대기중");
+        for (const auto& user : users["users"]) {
+            const std::string status = flag ? "게임중" : "대기중";
+            auto session = sessions_.findByUser(user.get<int>());
+            if (!session) {
+                // 재개를 기다리는 유저는 재개할 때 받을 상태만 갱신
+                detached_.updateStatus(user.get<int>(), status);
+                continue;
             }
+            session->setStatus(status);
         }
     }
 
@@ -76,9 +111,12 @@ namespace game_server {
         return version_;
     }
 
+    bool Server::isRunning() const {
+        return running_;
+    }
+
     bool Server::checkAlreadyLogin(int userId) {
-        std::lock_guard<std::mutex> lock(tokens_mutex_);
-        return tokens_.count(userId) > 0;
+        return sessions_.containsUser(userId);
     }
 
     void Server::setSessionTimeout(std::chrono::seconds timeout) {
@@ -86,61 +124,90 @@ namespace game_server {
         spdlog::info("세션 타임아웃 발생 {} 초", timeout.count());
     }
 
-    void Server::startSessionTimeoutCheck() {
-        if (timeout_check_running_) return;
-        timeout_check_running_ = true;
-        check_inactive_sessions();
+    std::chrono::seconds Server::getSessionTimeout() const {
+        return session_timeout_;
     }
 
-    void Server::check_inactive_sessions() {
-        if (!running_ || !timeout_check_running_) return;
-        spdlog::debug("유효하지 않은 세션 체크 중...");
+    void Server::setSessionResumeGrace(std::chrono::seconds grace) {
+        resume_grace_ = grace;
+        spdlog::info("세션 재개 유예 시간 {} 초", grace.count());
+    }
 
-        std::vector<std::string> sessionsToRemove;
-        {
-            std::lock_guard<std::mutex> lock(sessions_mutex_);
-            for (const auto& [token, wsession] : sessions_) {
-                auto session = wsession.lock();
-                if (!session) {
-                    // 세션이 이미 소멸됨
-                    spdlog::info("세션 {}가 이미 소멸되었습니다.", token);
-                    sessionsToRemove.push_back(token);
-                }
-                else if (!session->isActive(session_timeout_)) {
-                    // 세션이 존재하지만 타임아웃됨
-                    spdlog::info("세션 {}가 {}초간 연결이 없어 타임아웃 되었습니다.",
-                        token, session_timeout_.count());
-                    sessionsToRemove.push_back(token);
-                }
-            }
+    bool Server::detachSession(const std::shared_ptr<Session>& session) {
+        std::lock_guard<std::mutex> lock(resume_mutex_);
+        // 새 연결이 이미 세션을 이어받은 경우 보관하지 않고 방 퇴장도 하지 않음
+        if (session->isSuperseded()) return true;
+        if (!running_ || resume_grace_.count() <= 0) return false;
+
+        DetachedSessionStore::State state{
+            session->getUserId(), session->getUserName(), session->getUserNickName(), session->getStatus() };
+        int userId = state.userId;
+        sessions_.remove(session->getToken(), userId);
+        detached_.add(session->getToken(), std::move(state), std::chrono::steady_clock::now() + resume_grace_);
+        spdlog::info("유저 ID : {}의 연결이 끊겨 {}초 동안 세션 재개를 기다립니다", userId, resume_grace_.count());
+        return true;
+    }
+
+    std::optional<DetachedSessionStore::State> Server::resumeSession(const std::string& token) {
+        std::lock_guard<std::mutex> lock(resume_mutex_);
+        if (auto state = detached_.take(token)) return state;
+
+        // 이전 연결이 아직 끊김을 감지하지 못한 경우 (모바일/와이파이 전환 등) 살아 있는 세션에서 상태를 인계
+        auto previous = sessions_.findByToken(token);
+        if (!previous || previous->getUserId() <= 0) return std::nullopt;
+
+        DetachedSessionStore::State state{
+            previous->getUserId(), previous->getUserName(), previous->getUserNickName(), previous->getStatus() };
+        sessions_.remove(token, state.userId);
+        previous->supersede();
+        ++live_resumes_;
+        return state;
+    }
+
+    void Server::discardDetachedSession(int userId) {
+        if (auto state = detached_.takeUser(userId)) {
+            spdlog::info("유저 ID : {}가 세션 재개 대신 새로 로그인하여 이전 세션을 정리합니다", userId);
+            releaseDetached(*state);
         }
+    }
+
+    void Server::releaseDetached(const DetachedSessionStore::State& state) {
+        exitRoomAfterClose(state.userId);
+        presence_.remove(state.userId);
+    }
+
+    void Server::exitRoomAfterClose(int userId) {
+        auto controller_it = controllers_.find("room");
+        if (controller_it == controllers_.end() || userId <= 0) return;
+
+        auto controller = controller_it->second;
+        auto task = [controller, userId]() {
+            try {
+                spdlog::debug("사용자 {}의 자동 방 퇴장 시도 중", userId);
+
+                json temp = {
+                    {"action", "exitRoom"},
+                    {"userId", userId}
+                };
+
+                QueryStats::RequestScope scope("exitRoom");
+                json response = controller->handleRequest(temp);
 
-        for (const auto& token : sessionsToRemove) {
-            std::shared_ptr<Session> session;
-            {
-                std::lock_guard<std::mutex> lock(sessions_mutex_);
-                auto it = sessions_.find(token);
-                if (it != sessions_.end()) {
-                    session = it->second.lock();
-                    sessions_.erase(it);  // 컬렉션에서 세션 제거
-                    spdlog::info("세션 {}가 서버로 부터 삭제되었습니다.", token);
+                if (response.contains("status") && response["status"] == "success") {
+                    spdlog::info("사용자 {}가 세션 종료 시 자동으로 방에서 퇴장하였습니다", userId);
                 }
             }
-
-            if (session) {
-                session->handle_error("세션 타임 아웃 발생");
+            catch (const std::exception& e) {
+                spdlog::error("방 퇴장 중 에러가 발생하였습니다. : {}", e.what());
             }
-        }
+        };
 
-        session_check_timer_.expires_after(std::chrono::seconds(10));
-        session_check_timer_.async_wait([this](const boost::system::error_code& ec) {
-            if (!ec) {
-                check_inactive_sessions();
-            }
-            });
+        // 워커 풀 대기열이 가득 찬 경우에도 퇴장은 반드시 처리
+        if (!worker_pool_->submit(task)) {
+            task();
+        }
     }
 
-
     void Server::startBroadcastTimer() {
         if (broadcast_running_) return;
         broadcast_running_ = true;
@@ -161,28 +228,184 @@ namespace game_server {
             });
     }
 
-    std::string Server::generateSessionToken() {
-        boost::uuids::uuid uuid = uuid_generator_();
-        return boost::uuids::to_string(uuid);
+    void Server::scheduleMetricsLog() {
+        if (!running_) return;
+        metrics_timer_.expires_after(metrics_interval_);
+        metrics_timer_.async_wait([this](const boost::system::error_code& ec) {
+            if (!ec) {
+                spdlog::info("서버 지표: {}", getMetrics().dump());
+                scheduleMetricsLog();
+            }
+            });
     }
 
-    std::string Server::registerSession(std::shared_ptr<Session> session) {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
+    void Server::scheduleLastLoginFlush() {
+        if (!running_) return;
+        last_login_timer_.expires_after(last_login_flush_interval_);
+        last_login_timer_.async_wait([this](const boost::system::error_code& ec) {
+            if (!ec) {
+                last_login_->flush();
+                scheduleLastLoginFlush();
+            }
+            });
+    }
 
-        // 기존 세션이 존재하면 제거
-        for (auto it = sessions_.begin(); it != sessions_.end(); ++it) {
-            if (it->second.lock() == session) {
-                spdlog::info("이전에 할당된 토큰 확인, 삭제 후 새로운 토큰 할당: {}", it->first);
-                sessions_.erase(it);
-                break;  // 한 개만 삭제하면 되므로 루프 종료
+    void Server::scheduleResumeSweep() {
+        if (!running_) return;
+        resume_sweep_timer_.expires_after(resume_sweep_interval_);
+        resume_sweep_timer_.async_wait([this](const boost::system::error_code& ec) {
+            if (!ec) {
+                for (const auto& state : detached_.takeExpired(std::chrono::steady_clock::now())) {
+                    spdlog::info("유저 ID : {}의 세션 재개 유예 시간이 지나 세션을 정리합니다", state.userId);
+                    releaseDetached(state);
+                }
+                scheduleResumeSweep();
+            }
+            });
+    }
+
+    void Server::scheduleConnectionLimiterSweep() {
+        if (!running_) return;
+        limiter_sweep_timer_.expires_after(limiter_sweep_interval_);
+        limiter_sweep_timer_.async_wait([this](const boost::system::error_code& ec) {
+            if (!ec) {
+                // 접속이 끝난 IP 항목 정리 (서로 다른 IP로 접속이 몰려도 테이블이 계속 커지지 않도록)
+                std::size_t removed = connection_limiter_.sweep();
+                if (removed > 0) {
+                    spdlog::debug("접속 제한 IP 항목 {}개 정리", removed);
+                }
+                scheduleConnectionLimiterSweep();
             }
+            });
+    }
+
+    WorkerPool& Server::getWorkerPool() {
+        return *worker_pool_;
+    }
+
+    json Server::getMetrics() {
+        auto worker = worker_pool_->getMetrics();
+        auto hasher = password_hasher_->getMetrics();
+        auto db = db_pool_->getMetrics();
+        auto writeBehind = write_behind_->getMetrics();
+        auto lastLogin = last_login_->getMetrics();
+        auto resume = detached_.getMetrics();
+        auto limiter = connection_limiter_.getMetrics();
+        json metrics = {
+            {"ccu", getCCU()},
+            {"roomCapacity", getRoomCapacity()},
+            {"workerPool", {
+                {"threads", worker.threads},
+                {"queueDepth", worker.queueDepth},
+                {"maxQueueDepth", worker.maxQueueDepth},
+                {"queueLimit", worker.queueLimit},
+                {"activeWorkers", worker.activeWorkers},
+                {"submitted", worker.submitted},
+                {"completed", worker.completed},
+                {"rejected", worker.rejected}
+            }},
+            {"passwordHasher", {
+                {"threads", hasher.threads},
+                {"queueDepth", hasher.queueDepth},
+                {"maxQueueDepth", hasher.maxQueueDepth},
+                {"activeWorkers", hasher.activeWorkers},
+                {"completed", hasher.completed},
+                {"rejected", hasher.rejected}
+            }},
+            {"dbPool", {
+                {"size", db.size},
+                {"inUse", db.inUse},
+                {"utilization", db.utilization},
+                {"waiting", db.waiting},
+                {"maxWaiting", db.maxWaiting},
+                {"acquired", db.acquired},
+                {"waited", db.waited},
+                {"avgWaitMs", db.avgWaitMs},
+                {"maxWaitMs", db.maxWaitMs},
+                {"timeouts", db.timeouts},
+                {"reconnects", db.reconnects},
+                {"replicaReads", db.replicaReads},
+                {"replicaFallbacks", db.replicaFallbacks}
+            }},
+            {"writeBehind", {
+                {"connected", writeBehind.connected},
+                {"pending", writeBehind.pending},
+                {"maxPending", writeBehind.maxPending},
+                {"enqueued", writeBehind.enqueued},
+                {"written", writeBehind.written},
+                {"failed", writeBehind.failed},
+                {"retried", writeBehind.retried},
+                {"batches", writeBehind.batches},
+                {"reconnects", writeBehind.reconnects}
+            }},
+            {"lastLogin", {
+                {"pending", lastLogin.pending},
+                {"recorded", lastLogin.recorded},
+                {"flushedRows", lastLogin.flushedRows},
+                {"flushes", lastLogin.flushes}
+            }},
+            {"connectionLimiter", {
+                {"trackedIps", limiter.trackedIps},
+                {"activeConnections", limiter.activeConnections},
+                {"accepted", limiter.accepted},
+                {"connectRateLimited", limiter.connectRateLimited},
+                {"handshakeRateLimited", limiter.handshakeRateLimited},
+                {"concurrentLimited", limiter.concurrentLimited}
+            }},
+            {"sessionResume", {
+                {"graceSeconds", resume_grace_.count()},
+                {"detached", resume.detached},
+                {"resumed", resume.resumed},
+                {"resumedLive", live_resumes_.load()},
+                {"expired", resume.expired},
+                {"takenOver", resume.takenOver}
+            }},
+            {"queries", QueryStats::snapshot()}
+        };
+        if (user_cache_) {
+            auto userCache = user_cache_->getMetrics();
+            metrics["userCache"] = {
+                {"size", userCache.size},
+                {"capacity", userCache.capacity},
+                {"hits", userCache.hits},
+                {"misses", userCache.misses},
+                {"hitRate", userCache.hitRate},
+                {"evictions", userCache.evictions},
+                {"invalidations", userCache.invalidations}
+            };
         }
+        if (const DbPool* replica = db_pool_->replica()) {
+            auto replicaDb = replica->getMetrics();
+            metrics["dbReplica"] = {
+                {"size", replicaDb.size},
+                {"inUse", replicaDb.inUse},
+                {"utilization", replicaDb.utilization},
+                {"waiting", replicaDb.waiting},
+                {"acquired", replicaDb.acquired},
+                {"avgWaitMs", replicaDb.avgWaitMs},
+                {"timeouts", replicaDb.timeouts},
+                {"reconnects", replicaDb.reconnects}
+            };
+        }
+        return metrics;
+    }
 
+    std::string Server::generateSessionToken() {
+        boost::uuids::uuid uuid;
+        {
+            // random_generator는 스레드 안전하지 않으므로 생성 시에만 잠금
+            std::lock_guard<std::mutex> lock(uuid_mutex_);
+            uuid = uuid_generator_();
+        }
+        return boost::uuids::to_string(uuid);
+    }
+
+    std::string Server::registerSession(std::shared_ptr<Session> session) {
+        // 기존에 할당된 토큰이 있으면 레지스트리가 세션 인덱스로 찾아 교체
         std::string token = generateSessionToken();
-        sessions_[token] = session;
         int userId = session->getUserId();
+        sessions_.add(token, session, userId);
         if (userId) {
-            tokens_[userId] = token;
             spdlog::info("유저ID : {}에게 토큰ID : {} 할당 완료", userId, token);
         }
         return token;
@@ -205,24 +428,12 @@ namespace game_server {
     }
 
     void Server::removeSession(const std::string& token, int userId) {
-        std::lock_guard<std::mutex> session_lock(sessions_mutex_);
-        std::lock_guard<std::mutex> token_lock(tokens_mutex_);
-
-        bool found = false;
-        auto it_session = sessions_.find(token);
-        if (it_session != sessions_.end()) {
-            sessions_.erase(it_session);
-            found = true;
-        }
-
-        auto it_token = tokens_.find(userId);
-        if (it_token != tokens_.end()) {
-            tokens_.erase(it_token);
-            found = true;
-        }
-        if (found) {
+        if (sessions_.remove(token, userId)) {
             spdlog::info("유저 ID : {}의 토큰 삭제 완료, 토큰 ID : {}", userId, token);
         }
+        if (userId > 0) {
+            presence_.remove(userId);
+        }
     }
 
     void Server::removeMirrorSession(int port) {
@@ -235,20 +446,8 @@ namespace game_server {
     }
 
     std::shared_ptr<Session> Server::getSession(const std::string& token) {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
-        auto it = sessions_.find(token);
-        if (it != sessions_.end()) {
-            auto session = it->second.lock();
-            if (session) {
-                return session;
-            }
-            else {
-                // 세션이 이미 소멸된 경우 맵에서 제거
-                sessions_.erase(it);
-                spdlog::info("토큰 ID : {}가 이미 삭제된 상태입니다, 세션 정보를 서버에서 제거하였습니다.", token);
-            }
-        }
-        return nullptr;
+        // 세션이 이미 소멸된 경우 레지스트리가 조회 시 토큰을 제거
+        return sessions_.findByToken(token);
     }
 
     std::shared_ptr<Session> Server::getMirrorSession(int port) {
@@ -269,8 +468,7 @@ namespace game_server {
     }
 
     int Server::getCCU() {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
-        return sessions_.size();
+        return static_cast<int>(sessions_.size());
     }
 
     int Server::getRoomCapacity() {
@@ -280,40 +478,31 @@ namespace game_server {
 
     std::vector<std::shared_ptr<Session>> Server::getWaitingSessions() {
         std::vector<std::shared_ptr<Session>> waitingSessions;
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
-        for (const auto& obj : sessions_) {
-            auto session = obj.second.lock();
-            if (!session || !session->getUserId()) continue;
+        sessions_.forEach([&waitingSessions](const std::shared_ptr<Session>& session) {
+            if (!session->getUserId()) return;
             if (session->getStatus() == "대기중") {
                 waitingSessions.push_back(session);
             }
-        }
+        });
         return waitingSessions;
     }
 
     void Server::broadcastCCU() {
-        json broadcast = {
-            {"action", "CCUList"},
-            {"users", json::array()}
-        };
-        std::vector<std::shared_ptr<Session>> waitingSessions;
-        {
-            std::lock_guard<std::mutex> lock(sessions_mutex_);
-            for (const auto& obj : sessions_) {
-                auto session = obj.second.lock();
-                if (!session || !session->getUserId()) continue;
-
-                json userInfo;
-                userInfo["nickName"] = session->getUserNickName();
-                userInfo["status"] = session->getStatus();
-                broadcast["users"].push_back(userInfo);
-
-                if (session->getStatus() == "대기중") {
-                    waitingSessions.push_back(session);
-                }
-            }
-        }
-        broadcastActiveUser(broadcast.dump(), waitingSessions);
+        // 이번 주기에 쌓인 접속자 변경 사항만 대기 중인 유저에게 전송
+        json delta = presence_.flushDelta();
+        if (delta.is_null()) return;
+
+        auto waitingSessions = getWaitingSessions();
+        broadcastActiveUser(delta, waitingSessions);
+    }
+
+    void Server::updatePresence(int userId, const std::string& nickName, const std::string& status) {
+        presence_.update(userId, nickName, status);
+    }
+
+    void Server::sendPresenceSnapshot(std::shared_ptr<Session> session) {
+        // 대기실 입장 또는 버전 불일치로 재동기화가 필요한 유저에게 전체 목록 전송
+        session->write_broadcast(std::make_shared<const EncodedMessage>(presence_.snapshot()));
     }
 
     void Server::broadcastLogin(const std::string& nickName) {
@@ -322,7 +511,7 @@ namespace game_server {
             {"nickName", nickName}
         };
         auto waitingSessions = getWaitingSessions();
-        broadcastActiveUser(broadcast.dump(), waitingSessions);
+        broadcastActiveUser(broadcast, waitingSessions);
     }
 
     void Server::broadcastChat(const std::string& nickName, const std::string& message) {
@@ -332,28 +521,41 @@ namespace game_server {
             {"message", message}
         };
         auto waitingSessions = getWaitingSessions();
-        broadcastActiveUser(broadcast.dump(), waitingSessions);
+        broadcastActiveUser(broadcast, waitingSessions);
     }
 
-    void Server::broadcastActiveUser(const std::string& message, const std::vector<std::shared_ptr<Session>>& sessions) {
+    void Server::broadcastActiveUser(const json& message, const std::vector<std::shared_ptr<Session>>& sessions) {
+        if (sessions.empty()) return;
+
+        // 인코딩별로 한 번만 직렬화한 불변 버퍼를 같은 인코딩의 세션들이 공유 (수신자별 복사 없음)
+        auto payload = std::make_shared<const EncodedMessage>(message);
         for (const auto& session : sessions) {
-            session->write_broadcast(message);
+            session->write_broadcast(payload);
         }
     }
 
     void Server::init_controllers() {
+        // 방 상태 메모리 테이블을 DB에서 재구성 (방/게임 레포지토리가 공유)
+        auto roomStore = std::make_shared<RoomStore>(db_pool_.get(), write_behind_.get());
+        roomStore->load();
+
         // 레포지토리 생성
-        auto userRepo = UserRepository::create(db_pool_.get());
-        auto roomRepo = RoomRepository::create(db_pool_.get());
-        auto gameRepo = GameRepository::create(db_pool_.get());
+        std::shared_ptr<UserRepository> userRepo = UserRepository::create(db_pool_.get(), last_login_.get());
+        if (user_cache_size_ > 0) {
+            // 재접속이 몰려도 사용자 조회는 메모리에서 처리되도록 캐시로 감쌈
+            user_cache_ = std::make_shared<CachedUserRepository>(userRepo, user_cache_size_);
+            userRepo = user_cache_;
+        }
+        auto roomRepo = RoomRepository::create(roomStore);
+        auto gameRepo = GameRepository::create(db_pool_.get(), roomStore);
 
-        std::shared_ptr<UserRepository> sharedUserRepo = std::move(userRepo);
+        std::shared_ptr<UserRepository> sharedUserRepo = userRepo;
         std::shared_ptr<RoomRepository> sharedRoomRepo = std::move(roomRepo);
         std::shared_ptr<GameRepository> sharedGameRepo = std::move(gameRepo);
         spdlog::info("레포지토리 객체 생성 및 포인터화 완료");
 
         // 서비스 생성
-        auto authService = AuthService::create(sharedUserRepo);
+        auto authService = AuthService::create(sharedUserRepo, password_hasher_.get());
         auto roomService = RoomService::create(sharedRoomRepo);
         auto gameService = GameService::create(sharedGameRepo);
         spdlog::info("레포지토리와 서비스 연동 및 서비스 객체 생성 완료");
@@ -369,8 +571,13 @@ namespace game_server {
     {
         running_ = true;
         do_accept();
-        startSessionTimeoutCheck();
         startBroadcastTimer();
+        scheduleMetricsLog();
+        scheduleLastLoginFlush();
+        scheduleConnectionLimiterSweep();
+        if (resume_grace_.count() > 0) {
+            scheduleResumeSweep();
+        }
         spdlog::info("서버 실행 완료, 클라이언트 연결 요청을 기다리는 중...");
     }
 
@@ -378,28 +585,30 @@ namespace game_server {
         if (!running_) return;  // 이미 중지된 경우 중복 실행 방지
 
         running_ = false;
-        timeout_check_running_ = false;
         broadcast_running_ = false;
 
         // 타이머 취소 및 대기
-        session_check_timer_.cancel();
         broadcast_timer_.cancel();
-
-        // 모든 세션에 종료 알림
-        {
-            std::lock_guard<std::mutex> lock(sessions_mutex_);
-            for (auto& [token, wsession] : sessions_) {
-                auto session = wsession.lock();
-                try {
-                    if (session) {
-                        session->handle_error("서버 중단으로 인한 연결 종료");
-                    }
-                }
-                catch (const std::exception& e) {
-                    spdlog::error("세션을 정리하던 중 에러가 발생하였습니다. : {}", e.what());
-                }
+        metrics_timer_.cancel();
+        last_login_timer_.cancel();
+        resume_sweep_timer_.cancel();
+        limiter_sweep_timer_.cancel();
+
+        // 모든 세션에 종료 알림 (세션 종료는 각 스트랜드에서 나중에 실행되므로 방 퇴장은 여기서 워커 풀에 맡김)
+        // 세션의 handle_error는 서버 중지 후에는 방 퇴장을 하지 않으므로 퇴장은 한 번만 처리됨
+        for (auto& session : sessions_.clear()) {
+            try {
+                exitRoomAfterClose(session->getUserId());
+                session->handle_error("서버 중단으로 인한 연결 종료");
+            }
+            catch (const std::exception& e) {
+                spdlog::error("세션을 정리하던 중 에러가 발생하였습니다. : {}", e.what());
             }
-            sessions_.clear();
+        }
+
+        // 재개를 기다리던 세션도 방 퇴장 처리
+        for (const auto& state : detached_.clear()) {
+            releaseDetached(state);
         }
 
         // acceptor 닫기
@@ -412,31 +621,46 @@ namespace game_server {
             spdlog::error("서버 종료 중 에러가 발생하였습니다. : {}", e.what());
         }
 
+        // 이미 맡긴 작업(로그인 처리, 방 퇴장)을 마친 뒤 아직 반영하지 않은 로그인 시각을 write-behind 큐로 넘김
+        worker_pool_->stop();
+        last_login_->flush();
+
+        // write-behind 큐가 DB에 모두 기록할 때까지 제한 시간 동안 기다림 (종료 후 들어오는 변경은 버림)
+        write_behind_->stop();
+
         spdlog::info("서버 중단");
     }
 
-    bool Server::allowConnection(const std::string& ipAddress) {
-        std::lock_guard<std::mutex> lock(connected_ips_mutex_);
-        if (connected_ips_.count(ipAddress)) {
-            return false;
-        }
-        connected_ips_.insert(ipAddress);
-        return true;
+    ConnectionLimiter::Admission Server::allowConnection(const std::string& ipAddress) {
+        return connection_limiter_.allowSession(ipAddress);
     }
 
     void Server::removeConnection(const std::string& ipAddress) {
-        std::lock_guard<std::mutex> lock(connected_ips_mutex_);
-        connected_ips_.erase(ipAddress);
+        connection_limiter_.release(ipAddress);
     }
 
     void Server::do_accept()
     {
+        // 새 연결마다 전용 스트랜드를 만들어 소켓에 바인딩
+        auto strand = boost::asio::make_strand(io_context_);
         acceptor_.async_accept(
-            [this](boost::system::error_code ec, boost::asio::ip::tcp::socket socket) {
+            strand,
+            [this, strand](boost::system::error_code ec, boost::asio::ip::tcp::socket socket) {
                 if (!ec) {
-                    // 세션 생성 및 시작
-                    auto session = std::make_shared<Session>(std::move(socket), controllers_, this);
-                    session->start();
+                    // 같은 IP의 새 연결이 너무 잦으면 세션을 만들지 않고 바로 닫음 (거절 건수는 지표로 확인)
+                    boost::system::error_code endpoint_ec;
+                    auto endpoint = socket.remote_endpoint(endpoint_ec);
+                    if (endpoint_ec || !connection_limiter_.allowAccept(endpoint.address().to_string())) {
+                        boost::system::error_code close_ec;
+                        socket.close(close_ec);
+                    }
+                    else {
+                        // 세션 생성 및 시작 (세션 스트랜드에서 실행)
+                        auto session = std::make_shared<Session>(std::move(socket), strand, controllers_, this);
+                        boost::asio::dispatch(strand, [session]() {
+                            session->start();
+                            });
+                    }
                 }
                 else {
                     spdlog::error("클라이언트 연결을 받아 들이던 중 에러가 발생하였습니다. : {}", ec.message());
@@ -5,14 +5,24 @@
 #include <string>
 #include <map>
 #include <unordered_map>
-#include <unordered_set>
 #include <mutex>
+#include <atomic>
+#include <optional>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <nlohmann/json.hpp>
 #include "../controller/controller.h"
+#include "presence_tracker.h"
+#include "session_registry.h"
+#include "detached_session_store.h"
+#include "connection_limiter.h"
 #include "../util/db_pool.h"
+#include "../util/worker_pool.h"
+#include "../util/password_hasher.h"
+#include "../util/write_behind_queue.h"
+#include "../repository/last_login_buffer.h"
+#include "../repository/cached_user_repository.h"
 
 namespace game_server {
 
@@ -25,11 +35,23 @@ namespace game_server {
         Server(boost::asio::io_context& io_context,
             short port,
             const std::string& db_connection_string,
-            const std::string& version);
+            const std::string& version,
+            int worker_threads,
+            std::size_t worker_queue_limit,
+            int db_pool_size,
+            std::chrono::milliseconds db_acquire_timeout,
+            const std::string& db_replica_connection_string,
+            int db_replica_pool_size,
+            bool db_replica_fallback,
+            std::size_t user_cache_size,
+            int hash_threads,
+            std::size_t hash_queue_limit,
+            const ConnectionLimiter::Config& connection_limits);
         ~Server();
 
         void run();
         void stop();
+        bool isRunning() const;
 
         // 세션 관리 메서드
         std::string registerSession(std::shared_ptr<Session> session);
@@ -42,47 +64,83 @@ namespace game_server {
         int getRoomCapacity();
         std::string generateSessionToken();
         void setSessionTimeout(std::chrono::seconds timeout);
-        void startSessionTimeoutCheck();
+        std::chrono::seconds getSessionTimeout() const;
+        void setSessionResumeGrace(std::chrono::seconds grace);
+
+        // 세션 재개 (연결이 끊긴 로그인 세션을 유예 시간 동안 보관하고 새 연결에 넘김)
+        bool detachSession(const std::shared_ptr<Session>& session);
+        std::optional<DetachedSessionStore::State> resumeSession(const std::string& token);
+        void discardDetachedSession(int userId);
+        void exitRoomAfterClose(int userId);
         void startBroadcastTimer();
         bool checkAlreadyLogin(int userId);
         std::string getServerVersion();
         std::vector<std::shared_ptr<Session>> getWaitingSessions();
         void broadcastCCU();
+        void updatePresence(int userId, const std::string& nickName, const std::string& status);
+        void sendPresenceSnapshot(std::shared_ptr<Session> session);
         void broadcastLogin(const std::string& nickName);
         void broadcastChat(const std::string& nickName, const std::string& message);
-        void broadcastActiveUser(const std::string& message, const std::vector<std::shared_ptr<Session>>& activeSessions);
+        void broadcastActiveUser(const json& message, const std::vector<std::shared_ptr<Session>>& activeSessions);
         void setSessionStatus(const json& users, bool flag);
-        bool allowConnection(const std::string& ipAddress);
+        ConnectionLimiter::Admission allowConnection(const std::string& ipAddress);
         void removeConnection(const std::string& ipAddress);
+        WorkerPool& getWorkerPool();
+        json getMetrics();
     private:
         void do_accept();
         void init_controllers();
-        void check_inactive_sessions();
         void scheduleBroadcast();
+        void scheduleMetricsLog();
+        void scheduleLastLoginFlush();
+        void scheduleResumeSweep();
+        void scheduleConnectionLimiterSweep();
+        void releaseDetached(const DetachedSessionStore::State& state);
 
         boost::asio::io_context& io_context_;
+        // 서버 타이머 핸들러는 이 스트랜드에서 직렬화되어 실행됨
+        boost::asio::strand<boost::asio::io_context::executor_type> strand_;
         boost::asio::ip::tcp::acceptor acceptor_;
         std::unique_ptr<DbPool> db_pool_;
+        std::unique_ptr<WriteBehindQueue> write_behind_; // 방 상태 DB 반영용 (컨트롤러보다 늦게, DB 풀보다 먼저 소멸)
+        std::unique_ptr<LastLoginBuffer> last_login_; // 로그인 시각 모음 (write-behind 큐보다 먼저 소멸하며 남은 시각 반영)
+        std::unique_ptr<PasswordHasher> password_hasher_; // 비밀번호 해싱 전용 (컨트롤러/워커 풀보다 먼저 생성, 늦게 소멸)
         std::map<std::string, std::shared_ptr<Controller>> controllers_;
-        bool running_;
+        std::shared_ptr<CachedUserRepository> user_cache_; // 사용자 조회 캐시 (지표 조회용, 비활성화 시 nullptr)
+        const std::size_t user_cache_size_;
+        std::unique_ptr<WorkerPool> worker_pool_; // 컨트롤러 작업 실행용 (DB 풀보다 먼저 소멸)
+        std::atomic<bool> running_;
 
         // 세션 관리 데이터
         std::unordered_map<int, std::weak_ptr<Session>> mirrors_;
         std::mutex mirrors_mutex_;
-        std::unordered_map<std::string, std::weak_ptr<Session>> sessions_;
-        std::mutex sessions_mutex_;
-        std::unordered_set<std::string> connected_ips_;
-        std::mutex connected_ips_mutex_;
-        std::unordered_map<int, std::string> tokens_;
-        std::mutex tokens_mutex_;
+        SessionRegistry sessions_;
+        ConnectionLimiter connection_limiter_; // IP별 동시 접속 수/접속 빈도 제한
         boost::uuids::random_generator uuid_generator_;
+        std::mutex uuid_mutex_;
         std::chrono::seconds session_timeout_{ 12 }; // 기본 12초
-        boost::asio::steady_timer session_check_timer_;
-        bool timeout_check_running_{ false };
 
+        // 세션 재개 대기 데이터 (유예 시간이 0이면 끊기는 즉시 방 퇴장)
+        DetachedSessionStore detached_;
+        std::mutex resume_mutex_; // 끊긴 세션 보관과 살아 있는 세션 인계를 직렬화
+        std::chrono::seconds resume_grace_{ 30 };
+        std::atomic<std::uint64_t> live_resumes_{ 0 }; // 끊김 감지 전의 살아 있는 세션에서 인계한 횟수
+        boost::asio::steady_timer resume_sweep_timer_;
+        const std::chrono::seconds resume_sweep_interval_ = std::chrono::seconds(1);
+
+        PresenceTracker presence_;
         boost::asio::steady_timer broadcast_timer_;
-        bool broadcast_running_ = false;
+        std::atomic<bool> broadcast_running_{ false };
         const std::chrono::seconds broadcast_interval_ = std::chrono::seconds(3);
+
+        boost::asio::steady_timer metrics_timer_;
+        const std::chrono::seconds metrics_interval_ = std::chrono::seconds(60);
+
+        boost::asio::steady_timer last_login_timer_;
+        const std::chrono::seconds last_login_flush_interval_ = std::chrono::seconds(5);
+
+        boost::asio::steady_timer limiter_sweep_timer_;
+        const std::chrono::seconds limiter_sweep_interval_ = std::chrono::seconds(10);
         
         // 버전 관리 데이터
         std::string version_;
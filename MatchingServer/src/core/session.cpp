@@ -3,23 +3,45 @@
 // 클라이언트와의 통신 세션을 처리하는 핵심 파일
 #include "session.h"
 #include "server.h"
+#include "../util/query_stats.h"
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <string>
+#include <vector>
 
 namespace game_server {
 
     using json = nlohmann::json;
 
+    namespace {
+        // 클라이언트 네트워크 문제로 연결이 끊긴 경우 (서버가 직접 닫은 경우는 제외)
+        bool isTransportDrop(const boost::system::error_code& ec) {
+            namespace error = boost::asio::error;
+            return ec == error::eof ||
+                ec == error::connection_reset ||
+                ec == error::connection_aborted ||
+                ec == error::broken_pipe ||
+                ec == error::timed_out ||
+                ec == error::network_down ||
+                ec == error::network_reset ||
+                ec == error::network_unreachable ||
+                ec == error::host_unreachable;
+        }
+    } // namespace
+
     Session::Session(boost::asio::ip::tcp::socket socket,
+        strand_type strand,
         std::map<std::string, std::shared_ptr<Controller>>& controllers,
         Server* server)
-        : socket_(std::move(socket)),
+        : strand_(std::move(strand)),
+        socket_(std::move(socket)),
         controllers_(controllers),
         user_id_(0),
         server_(server),
         last_activity_time_(std::chrono::steady_clock::now()),
+        idle_timer_(strand_),
         remote_ip_(socket_.remote_endpoint().address().to_string())
     {
         spdlog::info("새 세션이 생성되었습니다. 주소: {}:{}",
@@ -34,9 +56,10 @@ namespace game_server {
                 server_->removeMirrorSession(mirror_port_);
             }
             if (!token_.empty()) {
-                server_->removeSession(token_, user_id_);
+                // 상태를 넘긴 세션은 유저 인덱스와 접속자 목록을 이어받은 쪽에 남겨 둠
+                server_->removeSession(token_, handed_off_ ? 0 : user_id_);
             }
-            if (!remote_ip_.empty()) {
+            if (connection_admitted_) {
                 server_->removeConnection(remote_ip_);
             }
         }
@@ -46,6 +69,10 @@ namespace game_server {
         // 서버에 세션 등록 및 토큰 받기
         token_ = server_->registerSession(shared_from_this());
         spdlog::info("세션이 초기화되었습니다. 토큰: {}", token_);
+
+        // 유휴 세션 타임아웃 감시 시작
+        last_activity_time_ = std::chrono::steady_clock::now();
+        arm_idle_timer(last_activity_time_ + server_->getSessionTimeout());
     }
 
     void Session::handlePing() {
@@ -59,14 +86,32 @@ namespace game_server {
             {"sessionToken", token_}
         };
 
-        write_response(response.dump());
+        write_response(response);
         spdlog::debug("핑 수신, 세션 {} 갱신됨", token_);
     }
 
-    bool Session::isActive(std::chrono::seconds timeout) const {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - last_activity_time_);
-        return elapsed < timeout;
+    // 핑은 마지막 활동 시각만 갱신하고, 타이머는 만료 시점에 남은 시간만큼 다시 설정
+    void Session::arm_idle_timer(std::chrono::steady_clock::time_point deadline) {
+        auto self(shared_from_this());
+        idle_timer_.expires_at(deadline);
+        idle_timer_.async_wait([this, self](const boost::system::error_code& ec) {
+            if (!ec) {
+                check_idle();
+            }
+            });
+    }
+
+    void Session::check_idle() {
+        if (!socket_.is_open()) return;
+
+        auto timeout = server_->getSessionTimeout();
+        auto deadline = last_activity_time_ + timeout;
+        if (std::chrono::steady_clock::now() >= deadline) {
+            spdlog::info("세션 {}가 {}초간 연결이 없어 타임아웃 되었습니다.", token_, timeout.count());
+            handle_error("세션 타임 아웃 발생");
+            return;
+        }
+        arm_idle_timer(deadline);
     }
 
     const std::string& Session::getToken() const {
@@ -83,12 +128,30 @@ namespace game_server {
         auto self(shared_from_this());
         socket_.async_read_some(
             boost::asio::buffer(buffer_),
-            [this, self](boost::system::error_code ec, std::size_t length) {                
+            [this, self](boost::system::error_code ec, std::size_t length) {
                 if (!ec) {
+                    if (!framer_.append(buffer_.data(), length)) {
+                        handle_error("핸드셰이크 메시지 크기 초과");
+                        return;
+                    }
+
+                    std::string data;
+                    if (!framer_.next(data)) {
+                        // 핸드셰이크 메시지가 아직 모두 도착하지 않음
+                        read_handshake();
+                        return;
+                    }
+
                     try {
-                        std::string data(buffer_.data(), length);
                         json handshake = json::parse(data);
 
+                        // 클라이언트가 요청한 인코딩 확인 (없거나 지원하지 않으면 JSON 유지)
+                        WireEncoding encoding = WireEncoding::Json;
+                        if (handshake.contains("encoding") && handshake["encoding"].is_string()) {
+                            encoding = WireCodec::parse(handshake["encoding"].get<std::string>())
+                                .value_or(WireEncoding::Json);
+                        }
+
                         // 미러 서버 구분 로직
                         if (handshake.contains("connectionType") &&
                             handshake["connectionType"] == "mirror" &&
@@ -101,24 +164,34 @@ namespace game_server {
 
                             // 미러 서버 전용 초기화
                             server_->registerMirrorSession(shared_from_this(), handshake["port"]);
-                            user_id_ = handshake["port"];
+                            {
+                                std::lock_guard<std::mutex> lock(state_mutex_);
+                                user_id_ = handshake["port"];
+                            }
 
                             // 확인 응답 전송
                             json response = {
                                 {"status", "success"},
-                                {"message", "미러 서버가 연결되었습니다"}
+                                {"message", "미러 서버가 연결되었습니다"},
+                                {"encoding", WireCodec::name(encoding)}
                             };
-                            write_handshake_response(response.dump());
+                            write_handshake_response(response);
+                            switch_encoding(encoding);
                         }
                         else {
-                            if (!server_->allowConnection(remote_ip_)) {
+                            auto admission = server_->allowConnection(remote_ip_);
+                            if (admission != ConnectionLimiter::Admission::Allowed) {
+                                bool too_many = admission == ConnectionLimiter::Admission::TooManyConnections;
                                 json response = {
                                     {"status", "error"},
-                                    {"message", "이미 접속 중인 IP입니다."}
+                                    {"message", too_many ? "같은 IP에서 허용된 동시 접속 수를 초과했습니다."
+                                        : "접속 시도가 너무 잦습니다. 잠시 후 다시 시도해주세요."}
                                 };
-                                write_handshake_response(response.dump());
-                                handle_error("다중 클라이언트 접속 감지 IP : " + remote_ip_);
+                                write_handshake_response(response);
+                                close_after_flush((too_many ? "동시 접속 수 초과 IP : " : "핸드셰이크 빈도 초과 IP : ") + remote_ip_);
+                                return;
                             }
+                            connection_admitted_ = true;
 
                             // 일반 클라이언트 세션 초기화
                             std::string serverVersion = server_->getServerVersion();
@@ -128,17 +201,20 @@ namespace game_server {
                             }
                             initialize();
 
-                            // 핸드셰이크가 실제 요청인 경우 처리
+                            // 핸드셰이크가 실제 요청인 경우 처리 (응답부터 협상된 인코딩 사용)
                             if (handshake.contains("action")) {
+                                switch_encoding(encoding);
                                 process_request(handshake);
                             }
                             else {
                                 // 일반 클라이언트에게 연결 확인 메시지 전송
                                 json response = {
                                     {"status", "success"},
-                                    {"message", "서버에 연결되었습니다"}
+                                    {"message", "서버에 연결되었습니다"},
+                                    {"encoding", WireCodec::name(encoding)}
                                 };
-                                write_handshake_response(response.dump());
+                                write_handshake_response(response);
+                                switch_encoding(encoding);
                             }
                         }
                     }
@@ -147,6 +223,10 @@ namespace game_server {
                         spdlog::error("핸드셰이크 오류: {}", e.what());
                         handle_error("잘못된 핸드셰이크 형식");
                     }
+
+                    // 핸드셰이크와 함께 들어온 요청을 처리하고 읽기 루프 시작
+                    process_buffered_frames();
+                    read_message();
                 }
                 else {
                     handle_error("핸드셰이크 읽기 오류: " + ec.message());
@@ -154,57 +234,78 @@ namespace game_server {
             });
     }
 
-    // 핸드셰이크 응답 전송 (응답 후 일반 메시지 처리로 전환)
-    void Session::write_handshake_response(const std::string& response) {
-        auto self(shared_from_this());
-        boost::asio::async_write(
-            socket_,
-            boost::asio::buffer(response),
-            [this, self](boost::system::error_code ec, std::size_t /*length*/) {
-                if (!ec) {
-                    // 핸드셰이크 완료 후 일반 메시지 처리 시작
-                    read_message();
-                }
-                else {
-                    handle_error("핸드셰이크 응답 쓰기 오류: " + ec.message());
-                }
-            });
+    // 핸드셰이크 응답 전송 (클라이언트가 협상 결과를 읽을 수 있도록 항상 JSON)
+    void Session::write_handshake_response(const json& response) {
+        enqueue_write(std::make_shared<const std::string>(WireCodec::encode(response, WireEncoding::Json)));
+    }
+
+    // 핸드셰이크 프레임 이후의 송수신 인코딩 전환
+    void Session::switch_encoding(WireEncoding encoding) {
+        encoding_ = encoding;
+        if (encoding != WireEncoding::Json) {
+            framer_.setLengthPrefixed();
+            spdlog::debug("세션 {} 인코딩 전환: {}", token_, WireCodec::name(encoding));
+        }
     }
 
+    // 읽기 루프: 응답 전송과 무관하게 항상 다음 요청을 읽음
     void Session::read_message() {
+        // 이미 읽기 대기 중이거나 종료된 세션이면 읽지 않음
+        if (read_in_progress_ || !socket_.is_open()) return;
+
+        read_in_progress_ = true;
         auto self(shared_from_this());
 
         // 비동기적으로 데이터 읽기
         socket_.async_read_some(
             boost::asio::buffer(buffer_),
             [this, self](boost::system::error_code ec, std::size_t length) {
-                if (!ec) {
-                    try {
-                        // 수신된 데이터를 문자열로 변환
-                        std::string data(buffer_.data(), length);
-
-                        // JSON 파싱
-                        json request = json::parse(data);
-
-                        // 요청 처리
-                        process_request(request);
-                    }
-                    catch (const std::exception& e) {
-                        // JSON 파싱 오류 등 예외 처리
-                        spdlog::error("요청 데이터 처리 중 오류: {}", e.what());
-                        json error_response = {
-                            {"status", "error"},
-                            {"message", "잘못된 요청 형식"}
-                        };
-                        write_response(error_response.dump());
-                    }
-                }
-                else {
+                read_in_progress_ = false;
+                if (ec) {
+                    resumable_ = isTransportDrop(ec);
                     handle_error("메시지 읽기 오류: " + ec.message());
+                    return;
+                }
+
+                if (!framer_.append(buffer_.data(), length)) {
+                    handle_error("최대 메시지 크기를 초과한 요청");
+                    return;
                 }
+
+                // 완성된 요청을 모두 처리한 뒤 응답 전송 완료를 기다리지 않고 바로 다음 읽기
+                process_buffered_frames();
+                read_message();
             });
     }
 
+    void Session::process_buffered_frames() {
+        // 한 번의 읽기에 여러 요청이 합쳐져 들어온 경우 모두 처리
+        // 워커 풀에서 처리 중인 요청이 있으면 완료될 때까지 다음 요청은 버퍼에 남겨 순서 유지
+        std::string frame;
+        while (socket_.is_open() && !request_in_flight_ && framer_.next(frame)) {
+            process_frame(frame);
+        }
+    }
+
+    void Session::process_frame(const std::string& frame) {
+        try {
+            // 협상된 인코딩으로 디코딩
+            json request = WireCodec::decode(frame, encoding_);
+
+            // 요청 처리
+            process_request(request);
+        }
+        catch (const std::exception& e) {
+            // JSON 파싱 오류 등 예외 처리
+            spdlog::error("요청 데이터 처리 중 오류: {}", e.what());
+            json error_response = {
+                {"status", "error"},
+                {"message", "잘못된 요청 형식"}
+            };
+            write_response(error_response);
+        }
+    }
+
     void Session::process_request(json& request) {
         try {
             spdlog::debug("요청 처리 중...");
@@ -224,7 +325,7 @@ namespace game_server {
                         {"status", "error"},
                         {"message", "인증이 필요합니다"}
                     };
-                    write_response(error_response.dump());
+                    write_response(error_response);
                     return;
                 }
 
@@ -237,7 +338,7 @@ namespace game_server {
                         {"status", "error"},
                         {"message", "권한이 없습니다."}
                     };
-                    write_response(error_response.dump());
+                    write_response(error_response);
                     return;
                 }
 
@@ -248,6 +349,10 @@ namespace game_server {
                 handlePing();
                 return;
             }
+            else if (action == "resume") {
+                resume_session(request);
+                return;
+            }
             else if (action == "logout") {
                 std::string logMessage = user_name_ + " 님이 로그아웃하였습니다";
                 handle_error(logMessage);
@@ -258,7 +363,20 @@ namespace game_server {
                 response["action"] = "roomCapacity";
                 response["status"] = "success";
                 response["roomCapacity"] = server_->getRoomCapacity();
-                write_response(response.dump());
+                write_response(response);
+                return;
+            }
+            else if (action == "CCUSync") {
+                // 클라이언트가 접속자 목록 버전 누락을 감지한 경우 전체 목록 재전송
+                if (user_id_ == 0) {
+                    json error_response = {
+                        {"status", "error"},
+                        {"message", "인증이 필요합니다"}
+                    };
+                    write_response(error_response);
+                    return;
+                }
+                server_->sendPresenceSnapshot(shared_from_this());
                 return;
             }
             else if (action == "CCU") {
@@ -266,7 +384,7 @@ namespace game_server {
                 response["action"] = "CCU";
                 response["status"] = "success";
                 response["roomCapacity"] = server_->getCCU();
-                write_response(response.dump());
+                write_response(response);
                 return;
             }
             else {
@@ -276,83 +394,14 @@ namespace game_server {
                     {"status", "error"},
                     {"message", "알 수 없는 액션"}
                 };
-                write_response(error_response.dump());
+                write_response(error_response);
                 return;
             }
 
             auto controller_it = controllers_.find(controller_type);
             if (controller_it != controllers_.end()) {
                 spdlog::debug("컨트롤러 찾음: {}", controller_type);
-                json response = controller_it->second->handleRequest(request);
-                spdlog::debug("컨트롤러 응답 수신됨");
-
-                if ((action == "login" || action == "SSAFYlogin") && response["status"] == "success") {
-                    spdlog::debug("로그인 응답 처리 중");
-                    if (server_->checkAlreadyLogin(response["userId"].get<int>())) {
-                        spdlog::error("사용자 ID: {}는 이미 로그인되어 있습니다", response["userId"].get<int>());
-                        json error_response = {
-                            {"status", "error"},
-                            {"message", "이미 로그인된 사용자입니다"}
-                        };
-                        write_response(error_response.dump());
-                        return;
-                    }
-
-                    init_current_user(response);
-                    std::string token = server_->registerSession(shared_from_this());
-                    token_ = token;
-                    response["sessionToken"] = token;
-                }
-                else if (action == "createRoom" && response["status"] == "success") {
-                    spdlog::debug("방 생성 응답 처리 중");
-
-                    // response 객체 디버깅 로그
-                    spdlog::debug("응답 내용: {}", response.dump());
-
-                    try {
-                        json broad_response;
-                        broad_response["action"] = "setRoom";
-                        broad_response["roomId"] = response["roomId"];
-                        broad_response["roomName"] = response["roomName"];
-                        broad_response["maxPlayers"] = response["maxPlayers"];
-
-                        auto mirror = server_->getMirrorSession(response["port"]);
-                        if (!mirror) {
-                            json error_response = {
-                                {"status", "error"},
-                                {"message", "미러 서버가 없습니다"}
-                            };
-                            spdlog::error("방 ID {}에 미러 서버가 없습니다", response["roomId"].get<int>());
-                            write_response(error_response.dump());
-                            return;
-                        }
-                        spdlog::debug("미러 서버 찾음, 메시지 브로드캐스팅");
-                        status_ = std::to_string(broad_response["roomId"].get<int>()) + "번 방";
-                        write_mirror(broad_response.dump(), mirror);
-                    }
-                    catch (const std::exception& e) {
-                        spdlog::error("방 생성 응답 처리 중 오류: {}", e.what());
-                        // 예외가 발생해도 원래 응답은 전송
-                    }
-                }
-                else if (action == "joinRoom" && response["status"] == "success") {
-                    status_ = std::to_string(response["roomId"].get<int>()) + "번 방";
-                }
-                else if (action == "exitRoom" && response["status"] == "success") {
-                    status_ = "대기중";
-                }
-                else if (action == "gameStart" && response["status"] == "success") {
-                    server_->setSessionStatus(response, true);
-                }
-                else if (action == "gameEnd" && response["status"] == "success") {
-                    server_->setSessionStatus(response, false);
-                }
-                else if (action == "updateNickName" && response["status"] == "success") {
-                    nick_name_ = response["nickName"];
-                }
-
-                spdlog::debug("클라이언트에 응답 전송 중");
-                write_response(response.dump());
+                dispatch_to_worker(controller_it->second, action, request);
             }
             else {
                 spdlog::error("컨트롤러를 찾지 못함: {}", controller_type);
@@ -360,7 +409,7 @@ namespace game_server {
                     {"status", "error"},
                     {"message", "내부 서버 오류"}
                 };
-                write_response(error_response.dump());
+                write_response(error_response);
             }
         }
         catch (const std::exception& e) {
@@ -372,80 +421,327 @@ namespace game_server {
                 {"status", "error"},
                 {"message", "잘못된 요청 형식"}
             };
-            write_response(error_response.dump());
+            write_response(error_response);
         }
     }
 
-    void Session::write_mirror(const std::string& response, std::shared_ptr<Session> mirror) {
-        boost::asio::async_write(
-            mirror->socket_,
-            boost::asio::buffer(response),
-            [mirror](boost::system::error_code ec, std::size_t /*length*/) {
-                if (!ec) {
-                    // 다음 요청 대기
-                    mirror->read_message();
+    // 연결이 끊긴 세션의 토큰으로 재인증 없이 유저 상태와 방 참가 상태를 이어받음
+    void Session::resume_session(const json& request) {
+        json response = { {"action", "resume"} };
+        if (user_id_ != 0 || is_mirror_) {
+            response["status"] = "error";
+            response["message"] = "이미 인증된 세션입니다.";
+            write_response(response);
+            return;
+        }
+        if (!request.contains("sessionToken") || !request["sessionToken"].is_string()) {
+            response["status"] = "error";
+            response["message"] = "세션 재개 요청에 필수 필드가 누락되었습니다.";
+            write_response(response);
+            return;
+        }
+
+        auto state = server_->resumeSession(request["sessionToken"].get<std::string>());
+        if (!state) {
+            response["status"] = "error";
+            response["message"] = "재개할 수 있는 세션이 없습니다. 다시 로그인해주세요.";
+            write_response(response);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            user_id_ = state->userId;
+            user_name_ = state->userName;
+            nick_name_ = state->nickName;
+            status_ = state->status;
+        }
+        token_ = server_->registerSession(shared_from_this());
+        server_->updatePresence(state->userId, state->nickName, state->status);
+        spdlog::info("{}유저가 세션을 재개하였습니다. (ID: {}) 상태 : {}", state->userName, state->userId, state->status);
+
+        response["status"] = "success";
+        response["message"] = "세션을 재개하였습니다.";
+        response["sessionToken"] = token_;
+        response["userId"] = state->userId;
+        response["userName"] = state->userName;
+        response["nickName"] = state->nickName;
+        response["userStatus"] = state->status;
+        write_response(response);
+
+        // 대기실 유저는 끊긴 동안 놓친 변경 사항 대신 전체 접속자 목록 전송
+        if (state->status == "대기중") {
+            server_->sendPresenceSnapshot(shared_from_this());
+        }
+    }
+
+    void Session::dispatch_to_worker(std::shared_ptr<Controller> controller, const std::string& action, json request) {
+        // 컨트롤러 호출(DB 작업 포함)은 워커 풀에서 실행하고 결과는 세션 스트랜드에서 처리
+        // 요청 순서를 지키기 위해 처리 중인 요청이 끝날 때까지 다음 프레임은 꺼내지 않음
+        auto self(shared_from_this());
+        request_in_flight_ = true;
+        bool accepted = server_->getWorkerPool().submit(
+            [self, controller, action, request]() mutable {
+                json response;
+                std::shared_ptr<const EncodedMessage> cached;
+                try {
+                    QueryStats::RequestScope scope(action);
+                    cached = controller->handleCachedRequest(request);
+                    if (!cached) {
+                        response = controller->handleRequest(request);
+                    }
                 }
-                else {
-                    mirror->handle_error("응답 쓰기 오류: " + ec.message());
+                catch (const std::exception& e) {
+                    spdlog::error("컨트롤러 처리 중 오류: {}, 액션: {}", e.what(), action);
+                    response = {
+                        {"status", "error"},
+                        {"message", "내부 서버 오류"}
+                    };
                 }
+
+                boost::asio::post(self->strand_, [self, action, response = std::move(response), cached]() mutable {
+                    self->request_in_flight_ = false;
+                    if (self->socket_.is_open()) {
+                        if (cached) {
+                            // 미리 인코딩된 응답은 세션 처리 없이 공유 버퍼를 그대로 전송
+                            self->enqueue_write(cached->get(self->encoding_));
+                        }
+                        else {
+                            self->complete_request(action, response);
+                        }
+                        self->process_buffered_frames();
+                    }
+                    else if (self->exit_room_pending_) {
+                        // 요청 처리 중에 연결이 종료된 경우 미뤄둔 방 퇴장 처리
+                        self->exit_room_pending_ = false;
+                        self->exit_room_on_close();
+                    }
+                    });
             });
+
+        if (!accepted) {
+            request_in_flight_ = false;
+            spdlog::warn("워커 풀 대기열이 가득 차 요청을 거절했습니다. 액션: {}", action);
+            json error_response = {
+                {"status", "error"},
+                {"message", "서버가 혼잡합니다. 잠시 후 다시 시도해주세요"}
+            };
+            write_response(error_response);
+        }
     }
 
-    void Session::write_broadcast(const std::string& response) {
-        auto self = shared_from_this();
-        boost::asio::async_write(
-            socket_,
-            boost::asio::buffer(response),
-            [self](boost::system::error_code ec, std::size_t /*length*/) {
-                if (ec) {
-                    self->handle_error("동접자 수 받기 에러: " + ec.message());
+    void Session::complete_request(const std::string& action, json& response) {
+        try {
+            spdlog::debug("컨트롤러 응답 수신됨");
+            bool joined_lobby = false;
+            if ((action == "login" || action == "SSAFYlogin") && response["status"] == "success") {
+                spdlog::debug("로그인 응답 처리 중");
+                // 세션 재개 대신 새로 로그인한 경우 재개를 기다리던 이전 세션 정리
+                server_->discardDetachedSession(response["userId"].get<int>());
+                if (server_->checkAlreadyLogin(response["userId"].get<int>())) {
+                    spdlog::error("사용자 ID: {}는 이미 로그인되어 있습니다", response["userId"].get<int>());
+                    json error_response = {
+                        {"status", "error"},
+                        {"message", "이미 로그인된 사용자입니다"}
+                    };
+                    write_response(error_response);
+                    return;
                 }
+
+                init_current_user(response);
+                std::string token = server_->registerSession(shared_from_this());
+                token_ = token;
+                response["sessionToken"] = token;
+                joined_lobby = true;
+            }
+            else if (action == "createRoom" && response["status"] == "success") {
+                spdlog::debug("방 생성 응답 처리 중");
+
+                // response 객체 디버깅 로그
+                spdlog::debug("응답 내용: {}", response.dump());
+
+                try {
+                    json broad_response;
+                    broad_response["action"] = "setRoom";
+                    broad_response["roomId"] = response["roomId"];
+                    broad_response["roomName"] = response["roomName"];
+                    broad_response["maxPlayers"] = response["maxPlayers"];
+
+                    auto mirror = server_->getMirrorSession(response["port"]);
+                    if (!mirror) {
+                        json error_response = {
+                            {"status", "error"},
+                            {"message", "미러 서버가 없습니다"}
+                        };
+                        spdlog::error("방 ID {}에 미러 서버가 없습니다", response["roomId"].get<int>());
+                        write_response(error_response);
+                        return;
+                    }
+                    spdlog::debug("미러 서버 찾음, 메시지 브로드캐스팅");
+                    setStatus(std::to_string(broad_response["roomId"].get<int>()) + "번 방");
+                    write_mirror(broad_response, mirror);
+                }
+                catch (const std::exception& e) {
+                    spdlog::error("방 생성 응답 처리 중 오류: {}", e.what());
+                    // 예외가 발생해도 원래 응답은 전송
+                }
+            }
+            else if (action == "joinRoom" && response["status"] == "success") {
+                setStatus(std::to_string(response["roomId"].get<int>()) + "번 방");
+            }
+            else if (action == "exitRoom" && response["status"] == "success") {
+                setStatus("대기중");
+            }
+            else if (action == "gameStart" && response["status"] == "success") {
+                server_->setSessionStatus(response, true);
+            }
+            else if (action == "gameEnd" && response["status"] == "success") {
+                server_->setSessionStatus(response, false);
+            }
+            else if (action == "updateNickName" && response["status"] == "success") {
+                std::string status;
+                {
+                    std::lock_guard<std::mutex> lock(state_mutex_);
+                    nick_name_ = response["nickName"];
+                    status = status_;
+                }
+                server_->updatePresence(user_id_, response["nickName"], status);
+            }
+
+            spdlog::debug("클라이언트에 응답 전송 중");
+            write_response(response);
+
+            // 로그인 직후에는 응답 뒤에 전체 접속자 목록 전송
+            if (joined_lobby) {
+                server_->sendPresenceSnapshot(shared_from_this());
+            }
+        }
+        catch (const std::exception& e) {
+            spdlog::error("요청 결과 처리 중 오류: {}, 액션: {}", e.what(), action);
+            json error_response = {
+                {"status", "error"},
+                {"message", "잘못된 요청 형식"}
+            };
+            write_response(error_response);
+        }
+    }
+
+    void Session::write_mirror(const json& message, std::shared_ptr<Session> mirror) {
+        // 미러 세션의 송신 큐와 인코딩은 미러 세션의 스트랜드에서만 다룸
+        boost::asio::post(mirror->strand_, [mirror, message]() {
+            mirror->enqueue_write(std::make_shared<const std::string>(WireCodec::encode(message, mirror->encoding_)));
             });
     }
 
-    void Session::write_response(const std::string& response) {
-        auto self(shared_from_this());
+    void Session::write_broadcast(std::shared_ptr<const EncodedMessage> message) {
+        // 브로드캐스트는 서버 스트랜드에서 호출되므로 세션 스트랜드로 넘겨서 큐에 추가
+        // 같은 인코딩을 쓰는 수신자들은 한 번 인코딩된 버퍼를 공유하며 전송이 끝날 때까지 송신 큐가 소유
+        auto self = shared_from_this();
+        boost::asio::post(strand_, [self, message = std::move(message)]() {
+            self->enqueue_write(message->get(self->encoding_));
+            });
+    }
+
+    void Session::write_response(const json& response) {
+        enqueue_write(std::make_shared<const std::string>(WireCodec::encode(response, encoding_)));
+    }
+
+    void Session::enqueue_write(std::shared_ptr<const std::string> message) {
+        if (!socket_.is_open()) return;
+
+        // 느린 클라이언트로 인해 송신 대기열이 무한히 쌓이지 않도록 제한
+        queued_bytes_ += message->size();
+        if (queued_bytes_ > kMaxQueuedBytes) {
+            handle_error("송신 대기열 한도 초과로 연결 종료");
+            return;
+        }
+
+        write_queue_.push_back(std::move(message));
+        if (!write_in_progress_) {
+            do_write();
+        }
+    }
+
+    void Session::do_write() {
+        // 대기 중인 메시지를 모아 한 번의 scatter/gather 쓰기로 전송
+        std::size_t count = std::min(write_queue_.size(), kMaxWriteBatch);
+        std::vector<boost::asio::const_buffer> buffers;
+        buffers.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            buffers.push_back(boost::asio::buffer(*write_queue_[i]));
+        }
 
-        // 클라이언트로 응답 데이터 전송
+        write_in_progress_ = true;
+        auto self(shared_from_this());
         boost::asio::async_write(
             socket_,
-            boost::asio::buffer(response),
-            [this, self](boost::system::error_code ec, std::size_t /*length*/) {
-                if (!ec) {
-                    // 다음 요청 대기
-                    read_message();
-                }
-                else {
+            buffers,
+            [this, self, count](boost::system::error_code ec, std::size_t /*length*/) {
+                write_in_progress_ = false;
+                if (ec) {
+                    write_queue_.clear();
+                    queued_bytes_ = 0;
+                    resumable_ = isTransportDrop(ec);
                     handle_error("응답 쓰기 오류: " + ec.message());
+                    return;
+                }
+
+                for (std::size_t i = 0; i < count; ++i) {
+                    queued_bytes_ -= write_queue_.front()->size();
+                    write_queue_.pop_front();
+                }
+
+                if (!write_queue_.empty()) {
+                    do_write();
+                }
+                else if (close_after_flush_) {
+                    handle_error(close_reason_);
                 }
             });
     }
 
+    // 거절 응답처럼 클라이언트가 받아야 하는 메시지를 보낸 뒤 연결 종료 (바로 닫으면 진행 중인 쓰기가 취소됨)
+    void Session::close_after_flush(const std::string& reason) {
+        if (!write_in_progress_ && write_queue_.empty()) {
+            handle_error(reason);
+            return;
+        }
+        close_after_flush_ = true;
+        close_reason_ = reason;
+    }
+
     void Session::handle_error(const std::string& error_message) {
+        // 서버 타이머 등 다른 스레드에서 호출된 경우 세션 스트랜드로 넘겨서 처리
+        if (!strand_.running_in_this_thread()) {
+            boost::asio::post(strand_, [self = shared_from_this(), error_message]() {
+                self->handle_error(error_message);
+                });
+            return;
+        }
+
         // 오류 로깅
         spdlog::info(error_message);
 
-        // 사용자가 방에 참여 중이라면 퇴장 처리
-        try {
-            auto controller_it = controllers_.find("room");
-            if (controller_it != controllers_.end() && user_id_ > 0) {
-                spdlog::debug("사용자 {}의 자동 방 퇴장 시도 중", user_id_);
-
-                json temp = {
-                    {"action", "exitRoom"},
-                    {"userId", user_id_}
-                };
-
-                json response = controller_it->second->handleRequest(temp);
+        // 네트워크 끊김으로 처음 종료되는 로그인 유저는 세션 상태를 재개 대기로 넘기고 방 퇴장은 유예 시간이 지난 뒤 처리
+        // 타임아웃, 송신 대기열 초과, 프로토콜 오류, 로그아웃 등 서버가 닫는 경우는 바로 방 퇴장
+        if (!handed_off_ && user_id_ > 0 && !is_mirror_ && ((resumable_ && socket_.is_open()) || superseded_)) {
+            handed_off_ = server_->detachSession(shared_from_this());
+        }
 
-                if (response.contains("status") && response["status"] == "success") {
-                    spdlog::info("사용자 {}가 세션 종료 시 자동으로 방에서 퇴장하였습니다", user_id_);
-                }
-            }
+        // 사용자가 방에 참여 중이라면 퇴장 처리 (처리 중인 요청이 있으면 완료 후 처리)
+        // 서버 중지 중에는 Server::stop이 워커 풀 종료 전에 퇴장을 맡기므로 여기서는 하지 않음
+        if (handed_off_ || !server_->isRunning()) {
+            exit_room_pending_ = false;
         }
-        catch (const std::exception& e) {
-            spdlog::error("방 퇴장 중 에러가 발생하였습니다. : {}", e.what());
+        else if (request_in_flight_) {
+            exit_room_pending_ = true;
         }
+        else {
+            exit_room_on_close();
+        }
+
+        // 유휴 타이머가 세션 수명을 붙잡지 않도록 취소
+        idle_timer_.cancel();
 
         if (socket_.is_open()) {
             boost::system::error_code ec;
@@ -464,31 +760,72 @@ namespace game_server {
         }
     }
 
+    void Session::exit_room_on_close() {
+        server_->exitRoomAfterClose(user_id_);
+    }
+
     int Session::getUserId() {
+        std::lock_guard<std::mutex> lock(state_mutex_);
         return user_id_;
     }
 
+    std::string Session::getUserName() {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        return user_name_;
+    }
+
     std::string Session::getUserNickName() {
+        std::lock_guard<std::mutex> lock(state_mutex_);
         return nick_name_;
     }
 
     void Session::setStatus(const std::string& status) {
-        status_ = status;
+        int userId;
+        std::string nickName;
+        bool returned_to_lobby;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            returned_to_lobby = status == "대기중" && status_ != "대기중";
+            status_ = status;
+            userId = user_id_;
+            nickName = nick_name_;
+        }
+
+        if (userId > 0 && !is_mirror_) {
+            server_->updatePresence(userId, nickName, status);
+            // 방/게임에 있는 동안 받지 못한 변경 사항 대신 전체 목록 전송
+            if (returned_to_lobby) {
+                server_->sendPresenceSnapshot(shared_from_this());
+            }
+        }
     }
 
     std::string Session::getStatus() {
+        std::lock_guard<std::mutex> lock(state_mutex_);
         return status_;
     }
 
+    bool Session::isSuperseded() const {
+        return superseded_;
+    }
+
+    // 새 연결이 세션을 이어받은 경우 이전 연결은 방 퇴장 없이 종료
+    void Session::supersede() {
+        superseded_ = true;
+        handle_error("새 연결에서 세션을 재개하여 이전 연결을 종료합니다");
+    }
+
     void Session::setToken(const std::string& token) {
         token_ = token;
     }
 
     void Session::init_current_user(const json& response) {
+        std::lock_guard<std::mutex> lock(state_mutex_);
         if (response.contains("userId")) user_id_ = response["userId"];
         if (response.contains("userName")) user_name_ = response["userName"];
         if (response.contains("nickName")) nick_name_ = response["nickName"];
         status_ = "대기중";
+        server_->updatePresence(user_id_, nick_name_, status_);
         spdlog::info("{}유저가 로그인 하였습니다. (ID: {}) 닉네임 : {}", user_name_, user_id_, nick_name_);
     }
 
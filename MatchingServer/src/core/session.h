@@ -1,11 +1,16 @@
 ﻿// core/session.h
 #pragma once
 #include "../controller/controller.h"
+#include "message_framer.h"
+#include "wire_codec.h"
 #include <boost/asio.hpp>
 #include <memory>
 #include <string>
 #include <array>
+#include <atomic>
+#include <deque>
 #include <map>
+#include <mutex>
 #include <nlohmann/json.hpp>
 
 namespace game_server {
@@ -15,7 +20,11 @@ namespace game_server {
 
     class Session : public std::enable_shared_from_this<Session> {
     public:
+        // 세션의 모든 핸들러는 이 스트랜드 위에서 직렬화되어 실행됨
+        using strand_type = boost::asio::strand<boost::asio::io_context::executor_type>;
+
         Session(boost::asio::ip::tcp::socket socket,
+            strand_type strand,
             std::map<std::string, std::shared_ptr<Controller>>& controllers,
             Server* server);
         ~Session();
@@ -24,38 +33,71 @@ namespace game_server {
         const std::string& getToken() const;
         void initialize();
         void handlePing();
-        bool isActive(std::chrono::seconds timeout) const;
         void handle_error(const std::string& error_message);
         void setToken(const std::string& token);
         int getUserId();
+        std::string getUserName();
         std::string getUserNickName();
         void setStatus(const std:: string& status);
         std::string getStatus();
-        void write_broadcast(const std::string& response);
+        void write_broadcast(std::shared_ptr<const EncodedMessage> message);
+        bool isSuperseded() const;
+        void supersede();
 
     private:
         void read_message();
+        void process_buffered_frames();
+        void process_frame(const std::string& frame);
         void process_request(json& request);
-        void write_response(const std::string& response);
+        void resume_session(const json& request);
+        void dispatch_to_worker(std::shared_ptr<Controller> controller, const std::string& action, json request);
+        void complete_request(const std::string& action, json& response);
+        void exit_room_on_close();
+        void arm_idle_timer(std::chrono::steady_clock::time_point deadline);
+        void check_idle();
+        void write_response(const json& response);
         void init_current_user(const json& response);
         void read_handshake();
-        void write_handshake_response(const std::string& response);
-        void write_mirror(const std::string& response, std::shared_ptr<Session> mirror);
+        void write_handshake_response(const json& response);
+        void switch_encoding(WireEncoding encoding);
+        void write_mirror(const json& message, std::shared_ptr<Session> mirror);
+        void enqueue_write(std::shared_ptr<const std::string> message);
+        void do_write();
+        void close_after_flush(const std::string& reason);
+
+        static constexpr std::size_t kMaxWriteBatch = 64;              // 한 번의 쓰기로 모을 최대 메시지 수
+        static constexpr std::size_t kMaxQueuedBytes = 4 * 1024 * 1024; // 세션별 송신 대기열 최대 크기
 
+        strand_type strand_;
         boost::asio::ip::tcp::socket socket_;
         std::map<std::string, std::shared_ptr<Controller>>& controllers_;
         std::array<char, 8192> buffer_;
-        std::string message_;
+        MessageFramer framer_;
+        WireEncoding encoding_ = WireEncoding::Json; // 핸드셰이크 이후 송수신에 사용하는 인코딩
+        bool read_in_progress_ = false;
+        bool request_in_flight_ = false;   // 워커 풀에서 처리 중인 요청 여부
+        bool exit_room_pending_ = false;   // 요청 처리 완료 후 방 퇴장 필요 여부
+        bool resumable_ = false;           // 연결 종료 시 세션 재개를 기다릴지 여부 (네트워크 끊김으로 종료된 경우만 true)
+        bool handed_off_ = false;          // 세션 상태를 재개 대기 또는 새 연결로 넘겼는지 여부
+        std::atomic<bool> superseded_{ false }; // 새 연결이 이 세션을 이어받았는지 여부
+        std::deque<std::shared_ptr<const std::string>> write_queue_; // 송신 대기 메시지
+        std::size_t queued_bytes_ = 0;
+        bool write_in_progress_ = false;
+        bool close_after_flush_ = false;   // 송신 대기열을 모두 보낸 뒤 연결 종료 여부
+        std::string close_reason_;
         int user_id_;
         std::string user_name_;
         std::string nick_name_;
         std::string status_;
+        mutable std::mutex state_mutex_; // 다른 스레드에서 조회되는 유저 정보/상태 보호
         Server* server_;
         std::chrono::steady_clock::time_point last_activity_time_;
+        boost::asio::steady_timer idle_timer_; // 마지막 활동 + 타임아웃 시점에 만료되는 세션별 타이머
         std::string token_;
         bool is_mirror_ = false;
         int mirror_port_;
         std::string remote_ip_;
+        bool connection_admitted_ = false; // 접속 제한기에서 동시 접속으로 집계되었는지 여부
     };
 
 } // namespace game_server
@@ -0,0 +1,156 @@
+﻿// core/session_registry.cpp
+// 세션 레지스트리 구현 파일
+// 여러 인덱스를 갱신할 때도 한 번에 하나의 샤드 잠금만 잡아 교착을 피함
+#include "session_registry.h"
+#include "session.h"
+
+namespace game_server {
+
+    void SessionRegistry::add(const std::string& token, const std::shared_ptr<Session>& session, int userId) {
+        // 세션 -> 토큰 인덱스로 이전 토큰 확인 후 교체
+        std::string previous;
+        {
+            auto& shard = shardFor(by_session_, static_cast<const Session*>(session.get()));
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto& current = shard.map[session.get()];
+            previous.swap(current);
+            current = token;
+        }
+        if (!previous.empty()) {
+            eraseToken(previous);
+        }
+
+        {
+            auto& shard = shardFor(by_token_, token);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (shard.map.emplace(token, TokenEntry{ session, session.get() }).second) {
+                ++count_;
+            }
+        }
+
+        if (userId) {
+            auto& shard = shardFor(by_user_, userId);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.map[userId] = UserEntry{ token, session };
+        }
+    }
+
+    bool SessionRegistry::remove(const std::string& token, int userId) {
+        bool found = false;
+        const Session* owner = nullptr;
+        {
+            auto& shard = shardFor(by_token_, token);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.map.find(token);
+            if (it != shard.map.end()) {
+                owner = it->second.owner;
+                shard.map.erase(it);
+                --count_;
+                found = true;
+            }
+        }
+
+        if (owner) {
+            auto& shard = shardFor(by_session_, owner);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.map.find(owner);
+            if (it != shard.map.end() && it->second == token) {
+                shard.map.erase(it);
+            }
+        }
+
+        if (userId) {
+            auto& shard = shardFor(by_user_, userId);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.map.find(userId);
+            if (it != shard.map.end() && it->second.token == token) {
+                shard.map.erase(it);
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    std::shared_ptr<Session> SessionRegistry::findByToken(const std::string& token) {
+        auto& shard = shardFor(by_token_, token);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.map.find(token);
+        if (it == shard.map.end()) return nullptr;
+        auto session = it->second.session.lock();
+        if (!session) {
+            // 세션이 이미 소멸된 경우 토큰 인덱스에서 제거
+            shard.map.erase(it);
+            --count_;
+        }
+        return session;
+    }
+
+    std::shared_ptr<Session> SessionRegistry::findByUser(int userId) {
+        auto& shard = shardFor(by_user_, userId);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.map.find(userId);
+        if (it == shard.map.end()) return nullptr;
+        return it->second.session.lock();
+    }
+
+    bool SessionRegistry::containsUser(int userId) {
+        auto& shard = shardFor(by_user_, userId);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.map.count(userId) > 0;
+    }
+
+    std::size_t SessionRegistry::size() const {
+        return count_.load();
+    }
+
+    void SessionRegistry::forEach(const std::function<void(const std::shared_ptr<Session>&)>& visitor) {
+        for (auto& shard : by_token_) {
+            std::vector<std::shared_ptr<Session>> alive;
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                alive.reserve(shard.map.size());
+                for (const auto& [token, entry] : shard.map) {
+                    if (auto session = entry.session.lock()) {
+                        alive.push_back(std::move(session));
+                    }
+                }
+            }
+            // 방문자는 잠금 밖에서 호출 (세션 메서드가 레지스트리를 다시 호출해도 안전)
+            for (const auto& session : alive) {
+                visitor(session);
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<Session>> SessionRegistry::clear() {
+        std::vector<std::shared_ptr<Session>> alive;
+        for (auto& shard : by_token_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (const auto& [token, entry] : shard.map) {
+                if (auto session = entry.session.lock()) {
+                    alive.push_back(std::move(session));
+                }
+            }
+            count_ -= shard.map.size();
+            shard.map.clear();
+        }
+        for (auto& shard : by_user_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.map.clear();
+        }
+        for (auto& shard : by_session_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.map.clear();
+        }
+        return alive;
+    }
+
+    void SessionRegistry::eraseToken(const std::string& token) {
+        auto& shard = shardFor(by_token_, token);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.map.erase(token) > 0) {
+            --count_;
+        }
+    }
+
+} // namespace game_server
@@ -0,0 +1,74 @@
+﻿// core/session_registry.h
+#pragma once
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace game_server {
+
+    class Session;
+
+    // 토큰/유저/세션 인덱스를 샤드 단위로 나눠 관리하는 세션 레지스트리
+    // 조회는 해당 키의 샤드 하나만 잠그며, 전체 접속자 수는 원자적 카운터로 유지
+    class SessionRegistry {
+    public:
+        static constexpr std::size_t kShardCount = 16;
+
+        // 세션에 새 토큰 등록, 이전에 받은 토큰이 있으면 교체하고 로그인한 유저는 유저 인덱스도 갱신
+        void add(const std::string& token, const std::shared_ptr<Session>& session, int userId);
+
+        // 토큰 삭제, 유저 인덱스는 같은 토큰을 가리킬 때만 삭제 (재로그인한 새 세션 보호)
+        bool remove(const std::string& token, int userId);
+
+        std::shared_ptr<Session> findByToken(const std::string& token);
+        std::shared_ptr<Session> findByUser(int userId);
+        bool containsUser(int userId);
+
+        // 등록된 토큰 수 (동시 접속자 수)
+        std::size_t size() const;
+
+        // 살아 있는 모든 세션 순회 (샤드를 하나씩 잠금)
+        void forEach(const std::function<void(const std::shared_ptr<Session>&)>& visitor);
+
+        // 모든 인덱스 비우고 비우기 전 살아 있던 세션 반환
+        std::vector<std::shared_ptr<Session>> clear();
+
+    private:
+        struct TokenEntry {
+            std::weak_ptr<Session> session;
+            const Session* owner;
+        };
+
+        struct UserEntry {
+            std::string token;
+            std::weak_ptr<Session> session;
+        };
+
+        template <typename Key, typename Value>
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_map<Key, Value> map;
+        };
+
+        template <typename Key, typename Value>
+        using ShardArray = std::array<Shard<Key, Value>, kShardCount>;
+
+        template <typename Key, typename Value>
+        static Shard<Key, Value>& shardFor(ShardArray<Key, Value>& shards, const Key& key) {
+            return shards[std::hash<Key>{}(key) % kShardCount];
+        }
+
+        void eraseToken(const std::string& token);
+
+        ShardArray<std::string, TokenEntry> by_token_;
+        ShardArray<int, UserEntry> by_user_;
+        ShardArray<const Session*, std::string> by_session_;
+        std::atomic<std::size_t> count_{ 0 };
+    };
+
+} // namespace game_server
@@ -0,0 +1,68 @@
+﻿// core/wire_codec.cpp
+// 메시지 인코딩 구현 파일
+// nlohmann::json의 MessagePack/CBOR 변환으로 바이너리 프로토콜 지원
+#include "wire_codec.h"
+#include <cstdint>
+#include <vector>
+
+namespace game_server {
+
+    std::optional<WireEncoding> WireCodec::parse(const std::string& name) {
+        if (name == "json") return WireEncoding::Json;
+        if (name == "msgpack") return WireEncoding::MessagePack;
+        if (name == "cbor") return WireEncoding::Cbor;
+        return std::nullopt;
+    }
+
+    const char* WireCodec::name(WireEncoding encoding) {
+        switch (encoding) {
+        case WireEncoding::MessagePack: return "msgpack";
+        case WireEncoding::Cbor: return "cbor";
+        default: return "json";
+        }
+    }
+
+    std::string WireCodec::encode(const json& message, WireEncoding encoding) {
+        if (encoding == WireEncoding::Json) {
+            std::string framed = message.dump();
+            framed.push_back('\n');
+            return framed;
+        }
+
+        std::vector<std::uint8_t> payload = encoding == WireEncoding::MessagePack
+            ? json::to_msgpack(message)
+            : json::to_cbor(message);
+
+        // 4바이트 빅엔디안 길이 접두사 뒤에 본문을 붙임
+        auto length = static_cast<std::uint32_t>(payload.size());
+        std::string framed;
+        framed.reserve(4 + payload.size());
+        framed.push_back(static_cast<char>((length >> 24) & 0xFF));
+        framed.push_back(static_cast<char>((length >> 16) & 0xFF));
+        framed.push_back(static_cast<char>((length >> 8) & 0xFF));
+        framed.push_back(static_cast<char>(length & 0xFF));
+        framed.append(payload.begin(), payload.end());
+        return framed;
+    }
+
+    json WireCodec::decode(const std::string& frame, WireEncoding encoding) {
+        switch (encoding) {
+        case WireEncoding::MessagePack: return json::from_msgpack(frame);
+        case WireEncoding::Cbor: return json::from_cbor(frame);
+        default: return json::parse(frame);
+        }
+    }
+
+    EncodedMessage::EncodedMessage(json message)
+        : message_(std::move(message)) {
+    }
+
+    std::shared_ptr<const std::string> EncodedMessage::get(WireEncoding encoding) const {
+        auto index = static_cast<std::size_t>(encoding);
+        std::call_once(once_[index], [this, encoding, index]() {
+            encoded_[index] = std::make_shared<const std::string>(WireCodec::encode(message_, encoding));
+            });
+        return encoded_[index];
+    }
+
+} // namespace game_server
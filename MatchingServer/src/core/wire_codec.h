@@ -0,0 +1,54 @@
+﻿// core/wire_codec.h
+#pragma once
+#include <array>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+
+    using json = nlohmann::json;
+
+    // 핸드셰이크에서 협상하는 메시지 인코딩
+    // JSON은 개행 구분 텍스트, 바이너리 인코딩은 4바이트 빅엔디안 길이 접두사로 프레이밍
+    enum class WireEncoding {
+        Json = 0,
+        MessagePack,
+        Cbor
+    };
+
+    class WireCodec {
+    public:
+        static constexpr std::size_t kEncodingCount = 3;
+
+        // 핸드셰이크의 "encoding" 값 해석, 지원하지 않는 값이면 nullopt
+        static std::optional<WireEncoding> parse(const std::string& name);
+        static const char* name(WireEncoding encoding);
+
+        // 메시지를 인코딩하고 프레임 구분(개행 또는 길이 접두사)까지 붙인 송신 버퍼 생성
+        static std::string encode(const json& message, WireEncoding encoding);
+
+        // 프레이머가 분리한 한 프레임을 디코딩, 형식 오류 시 json 예외 발생
+        static json decode(const std::string& frame, WireEncoding encoding);
+    };
+
+    // 여러 세션에 보내는 브로드캐스트 메시지
+    // 수신자들이 사용하는 인코딩별로 처음 요청될 때 한 번만 인코딩하고 버퍼를 공유
+    class EncodedMessage {
+    public:
+        explicit EncodedMessage(json message);
+
+        // 여러 세션 스트랜드에서 동시에 호출 가능
+        std::shared_ptr<const std::string> get(WireEncoding encoding) const;
+
+        const json& message() const { return message_; }
+
+    private:
+        const json message_;
+        mutable std::array<std::once_flag, WireCodec::kEncodingCount> once_;
+        mutable std::array<std::shared_ptr<const std::string>, WireCodec::kEncodingCount> encoded_;
+    };
+
+} // namespace game_server
@@ -5,24 +5,15 @@
 #include <iostream>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
-#include <csignal>
 #include <cstdlib>
 #include <string>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <algorithm>
 
-// 시그널 핸들러용 전역 서버 변수
 std::unique_ptr<game_server::Server> server;
 
-// 시그널 핸들러 함수
-void signal_handler(int signal)
-{
-    spdlog::info("시그널 받음 {}, 서버 종료...", signal);
-    if (server) {
-        server->stop();
-    }
-    std::exit(0);
-    exit(signal);
-}
-
 int main(int argc, char* argv[])
 {
     try {
@@ -31,10 +22,6 @@ int main(int argc, char* argv[])
         spdlog::set_default_logger(console);
         spdlog::set_level(spdlog::level::info);
 
-        // 시그널 핸들러 등록
-        std::signal(SIGINT, signal_handler);
-        std::signal(SIGTERM, signal_handler);
-
         // 기본 설정
         short port = atoi(std::getenv("SERVER_PORT"));
         std::string version = std::getenv("SERVER_VERSION");
@@ -46,19 +33,157 @@ int main(int argc, char* argv[])
         std::string db_connection_string =
             "dbname=" + db_name + " user=" + db_user + " password=" + db_password + " host=" + db_host +  " port=" + db_port +" client_encoding=UTF8";
 
-        spdlog::info("환경 변수 불러오기 완료! 매칭 서버 버전 : {}, 포트 번호 : {}", version, port);
+        // IO 스레드 수 (미설정 시 하드웨어 코어 수)
+        int thread_count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        if (const char* env = std::getenv("SERVER_THREADS")) {
+            int configured = atoi(env);
+            if (configured > 0) thread_count = configured;
+        }
+
+        // 컨트롤러/DB 작업을 처리할 워커 스레드 수 및 대기열 한도
+        int worker_threads = 16;
+        if (const char* env = std::getenv("WORKER_THREADS")) {
+            int configured = atoi(env);
+            if (configured > 0) worker_threads = configured;
+        }
+        std::size_t worker_queue_limit = 1024;
+        if (const char* env = std::getenv("WORKER_QUEUE_LIMIT")) {
+            int configured = atoi(env);
+            if (configured > 0) worker_queue_limit = configured;
+        }
+
+        // DB 연결 풀 크기(최대 연결 수) 및 연결 대기 제한 시간
+        int db_pool_size = 20;
+        if (const char* env = std::getenv("DB_POOL_SIZE")) {
+            int configured = atoi(env);
+            if (configured > 0) db_pool_size = configured;
+        }
+        std::chrono::milliseconds db_acquire_timeout(3000);
+        if (const char* env = std::getenv("DB_ACQUIRE_TIMEOUT_MS")) {
+            int configured = atoi(env);
+            if (configured > 0) db_acquire_timeout = std::chrono::milliseconds(configured);
+        }
+
+        // 읽기 전용 복제본 (DB_REPLICA_HOST 설정 시 사용자 조회 등 읽기 쿼리를 복제본으로 분산)
+        std::string db_replica_connection_string;
+        int db_replica_pool_size = db_pool_size;
+        bool db_replica_fallback = true;
+        if (const char* replica_host = std::getenv("DB_REPLICA_HOST"); replica_host && *replica_host) {
+            std::string replica_port = db_port;
+            if (const char* env = std::getenv("DB_REPLICA_PORT"); env && *env) replica_port = env;
+            db_replica_connection_string =
+                "dbname=" + db_name + " user=" + db_user + " password=" + db_password + " host=" + replica_host + " port=" + replica_port + " client_encoding=UTF8";
+            if (const char* env = std::getenv("DB_REPLICA_POOL_SIZE")) {
+                int configured = atoi(env);
+                if (configured > 0) db_replica_pool_size = configured;
+            }
+            if (const char* env = std::getenv("DB_REPLICA_FALLBACK"); env && *env) {
+                db_replica_fallback = atoi(env) != 0;
+            }
+        }
+
+        // 사용자 조회 캐시 크기 (0이면 캐시 사용 안 함)
+        std::size_t user_cache_size = 10000;
+        if (const char* env = std::getenv("USER_CACHE_SIZE"); env && *env) {
+            int configured = atoi(env);
+            if (configured >= 0) user_cache_size = configured;
+        }
+
+        // 비밀번호 해싱 전용 스레드 수 (미설정 시 코어 수의 절반) 및 대기열 한도
+        int hash_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) / 2);
+        if (const char* env = std::getenv("HASH_THREADS"); env && *env) {
+            int configured = atoi(env);
+            if (configured > 0) hash_threads = configured;
+        }
+        std::size_t hash_queue_limit = 256;
+        if (const char* env = std::getenv("HASH_QUEUE_LIMIT"); env && *env) {
+            int configured = atoi(env);
+            if (configured > 0) hash_queue_limit = configured;
+        }
+
+        // IP별 동시 접속 수와 초당 새 연결/핸드셰이크 허용 수 (0이면 해당 제한 사용 안 함)
+        game_server::ConnectionLimiter::Config connection_limits;
+        if (const char* env = std::getenv("MAX_CONNECTIONS_PER_IP"); env && *env) {
+            int configured = atoi(env);
+            if (configured >= 0) connection_limits.maxConnectionsPerIp = configured;
+        }
+        if (const char* env = std::getenv("CONNECT_RATE_PER_IP"); env && *env) {
+            double configured = atof(env);
+            if (configured >= 0) connection_limits.connectRate = configured;
+        }
+        if (const char* env = std::getenv("CONNECT_BURST_PER_IP"); env && *env) {
+            double configured = atof(env);
+            if (configured >= 1) connection_limits.connectBurst = configured;
+        }
+        if (const char* env = std::getenv("HANDSHAKE_RATE_PER_IP"); env && *env) {
+            double configured = atof(env);
+            if (configured >= 0) connection_limits.handshakeRate = configured;
+        }
+        if (const char* env = std::getenv("HANDSHAKE_BURST_PER_IP"); env && *env) {
+            double configured = atof(env);
+            if (configured >= 1) connection_limits.handshakeBurst = configured;
+        }
+
+        // 연결이 끊긴 로그인 세션의 재개 유예 시간 (0이면 세션 재개 사용 안 함)
+        std::chrono::seconds session_resume_grace(30);
+        if (const char* env = std::getenv("SESSION_RESUME_GRACE_SECONDS"); env && *env) {
+            int configured = atoi(env);
+            if (configured >= 0) session_resume_grace = std::chrono::seconds(configured);
+        }
+
+        spdlog::info("환경 변수 불러오기 완료! 매칭 서버 버전 : {}, 포트 번호 : {}, IO 스레드 수 : {}, 워커 스레드 수 : {}",
+            version, port, thread_count, worker_threads);
 
         // IO 컨텍스트 및 서버 생성
-        boost::asio::io_context io_context;
+        boost::asio::io_context io_context(thread_count);
         server = std::make_unique<game_server::Server>(
-            io_context, port, db_connection_string, version);
+            io_context, port, db_connection_string, version, worker_threads, worker_queue_limit,
+            db_pool_size, db_acquire_timeout, db_replica_connection_string, db_replica_pool_size, db_replica_fallback,
+            user_cache_size, hash_threads, hash_queue_limit, connection_limits);
+        server->setSessionResumeGrace(session_resume_grace);
 
         // 서버 실행
         server->run();
 
-        // IO 컨텍스트 실행 (이벤트 루프)
+        // 종료 시그널은 IO 스레드에서 처리: 남은 DB 기록을 마친 뒤 IO 컨텍스트를 멈추고 main에서 정상 반환
+        boost::asio::signal_set signals(io_context, SIGINT, SIGTERM);
+        signals.async_wait([&io_context](const boost::system::error_code& ec, int signal) {
+            if (ec) return;
+            spdlog::info("시그널 받음 {}, 서버 종료...", signal);
+            server->stop();
+            io_context.stop();
+            });
+
+        // IO 컨텍스트 실행 (이벤트 루프), 핸들러 예외로 스레드가 종료되지 않도록 재진입
+        auto run_io_context = [&io_context]() {
+            for (;;) {
+                try {
+                    io_context.run();
+                    break;
+                }
+                catch (const std::exception& e) {
+                    spdlog::error("IO 스레드에서 처리되지 않은 예외 발생: {}", e.what());
+                }
+            }
+        };
+
         spdlog::info("서버 시작, 포트 : {}", port);
-        io_context.run();
+        std::vector<std::thread> io_threads;
+        io_threads.reserve(thread_count - 1);
+        for (int i = 1; i < thread_count; ++i) {
+            io_threads.emplace_back(run_io_context);
+        }
+        run_io_context();
+
+        for (auto& thread : io_threads) {
+            thread.join();
+        }
+
+        // Server::stop이 세션 스트랜드에 넘긴 종료 처리와 그로 인한 취소 핸들러를 서버 소멸 전에 실행
+        // (남겨 두면 IO 컨텍스트 소멸 시 세션이 해제되면서 이미 해제된 서버에 접근함)
+        io_context.restart();
+        io_context.poll();
+        server.reset();
     }
     catch (std::exception& e) {
         spdlog::error("서버 설정 중 예외 발생: {}", e.what());
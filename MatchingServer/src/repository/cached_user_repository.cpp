@@ -0,0 +1,162 @@
+﻿// repository/cached_user_repository.cpp
+// 사용자 캐시 리포지토리 구현 파일
+// 찾지 못한 결과(userId -1)는 DB 오류와 구분할 수 없으므로 저장하지 않음
+#include "cached_user_repository.h"
+#include "../util/time_util.h"
+#include <algorithm>
+#include <cctype>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    using json = nlohmann::json;
+
+    CachedUserRepository::CachedUserRepository(std::shared_ptr<UserRepository> inner, std::size_t capacity)
+        : inner_(std::move(inner)), capacity_(capacity) {
+    }
+
+    std::string CachedUserRepository::normalize(const std::string& username) {
+        // DB 조회 조건 LOWER(user_name) = LOWER($1)과 같은 기준 (사용자 이름은 ASCII만 허용)
+        std::string key = username;
+        std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return std::tolower(c); });
+        return key;
+    }
+
+    json CachedUserRepository::findByUsername(const std::string& username) {
+        std::string key = normalize(username);
+        std::uint64_t generation;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = by_key_.find(key);
+            if (it != by_key_.end()) {
+                if (it->second->expiresAt > std::chrono::steady_clock::now()) {
+                    entries_.splice(entries_.begin(), entries_, it->second);
+                    ++hits_;
+                    return it->second->user;
+                }
+                eraseLocked(it->second);
+            }
+            generation = generation_;
+        }
+
+        ++misses_;
+        json user = inner_->findByUsername(username);
+        store(key, user, generation);
+        return user;
+    }
+
+    json CachedUserRepository::findByUsernameFromPrimary(const std::string& username) {
+        // 캐시를 거치지 않고 최신 정보를 읽은 뒤 캐시도 갱신
+        std::uint64_t generation;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            generation = generation_;
+        }
+        json user = inner_->findByUsernameFromPrimary(username);
+        store(normalize(username), user, generation);
+        return user;
+    }
+
+    int CachedUserRepository::create(const std::string& username, const std::string& hashedPassword) {
+        int userId = inner_->create(username, hashedPassword);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++generation_;
+        auto it = by_key_.find(normalize(username));
+        if (it != by_key_.end()) {
+            eraseLocked(it->second);
+            ++invalidations_;
+        }
+        return userId;
+    }
+
+    bool CachedUserRepository::updateLastLogin(int userId) {
+        if (!inner_->updateLastLogin(userId)) return false;
+
+        // 다음 로그인 응답의 lastLogin이 DB 조회 결과와 같도록 캐시 항목도 갱신
+        std::string now = TimeUtil::currentTimestamp();
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto user_it = keys_by_user_.find(userId);
+        if (user_it == keys_by_user_.end()) return true;
+        for (const auto& key : user_it->second) {
+            auto it = by_key_.find(key);
+            if (it != by_key_.end()) {
+                it->second->user["lastLogin"] = now;
+            }
+        }
+        return true;
+    }
+
+    bool CachedUserRepository::updateUserNickName(int userId, const std::string& nickName) {
+        bool updated = inner_->updateUserNickName(userId, nickName);
+        invalidateUser(userId);
+        return updated;
+    }
+
+    void CachedUserRepository::store(const std::string& key, const json& user, std::uint64_t generation) {
+        if (capacity_ == 0 || !user.contains("userId") || user["userId"] == -1) return;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (generation != generation_) return;
+
+        auto it = by_key_.find(key);
+        if (it != by_key_.end()) {
+            eraseLocked(it->second);
+        }
+
+        int userId = user["userId"].get<int>();
+        entries_.push_front(Entry{ key, user, std::chrono::steady_clock::now() + kEntryTtl });
+        by_key_[key] = entries_.begin();
+        keys_by_user_[userId].push_back(key);
+
+        while (entries_.size() > capacity_) {
+            eraseLocked(std::prev(entries_.end()));
+            ++evictions_;
+        }
+    }
+
+    void CachedUserRepository::invalidateUser(int userId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++generation_;
+        auto user_it = keys_by_user_.find(userId);
+        if (user_it == keys_by_user_.end()) return;
+
+        std::vector<std::string> keys = user_it->second;
+        for (const auto& key : keys) {
+            auto it = by_key_.find(key);
+            if (it != by_key_.end()) {
+                eraseLocked(it->second);
+                ++invalidations_;
+            }
+        }
+    }
+
+    void CachedUserRepository::eraseLocked(EntryList::iterator it) {
+        int userId = it->user["userId"].get<int>();
+        auto user_it = keys_by_user_.find(userId);
+        if (user_it != keys_by_user_.end()) {
+            auto& keys = user_it->second;
+            keys.erase(std::remove(keys.begin(), keys.end(), it->key), keys.end());
+            if (keys.empty()) keys_by_user_.erase(user_it);
+        }
+        by_key_.erase(it->key);
+        entries_.erase(it);
+    }
+
+    CachedUserRepository::Metrics CachedUserRepository::getMetrics() const {
+        Metrics metrics;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            metrics.size = entries_.size();
+        }
+        metrics.capacity = capacity_;
+        metrics.hits = hits_;
+        metrics.misses = misses_;
+        metrics.evictions = evictions_;
+        metrics.invalidations = invalidations_;
+        std::uint64_t lookups = metrics.hits + metrics.misses;
+        metrics.hitRate = lookups ? static_cast<double>(metrics.hits) / lookups : 0.0;
+        return metrics;
+    }
+
+} // namespace game_server
@@ -0,0 +1,73 @@
+﻿// repository/cached_user_repository.h
+#pragma once
+#include "user_repository.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace game_server {
+
+    // 사용자 이름(소문자 정규화)으로 조회한 사용자 정보를 메모리에 두는 크기 제한 LRU 캐시
+    // 다른 리포지토리 구현을 감싸며, 생성/닉네임 변경 시 해당 사용자 항목을 무효화
+    class CachedUserRepository : public UserRepository {
+    public:
+        struct Metrics {
+            std::size_t size;
+            std::size_t capacity;
+            std::uint64_t hits;
+            std::uint64_t misses;
+            std::uint64_t evictions;
+            std::uint64_t invalidations;
+            double hitRate;
+        };
+
+        // 다른 서버가 같은 사용자를 변경할 수 있으므로 항목은 일정 시간 후 만료
+        static constexpr std::chrono::seconds kEntryTtl{ 300 };
+
+        CachedUserRepository(std::shared_ptr<UserRepository> inner, std::size_t capacity);
+
+        nlohmann::json findByUsername(const std::string& username) override;
+        nlohmann::json findByUsernameFromPrimary(const std::string& username) override;
+        int create(const std::string& username, const std::string& hashedPassword) override;
+        bool updateLastLogin(int userId) override;
+        bool updateUserNickName(int userId, const std::string& nickName) override;
+
+        Metrics getMetrics() const;
+
+    private:
+        struct Entry {
+            std::string key;
+            nlohmann::json user;
+            std::chrono::steady_clock::time_point expiresAt;
+        };
+        using EntryList = std::list<Entry>;
+
+        static std::string normalize(const std::string& username);
+
+        // 조회 전 읽어 둔 무효화 세대가 그대로일 때만 저장 (조회 중 변경된 옛 정보를 넣지 않기 위함)
+        void store(const std::string& key, const nlohmann::json& user, std::uint64_t generation);
+        void invalidateUser(int userId);
+        void eraseLocked(EntryList::iterator it);
+
+        std::shared_ptr<UserRepository> inner_;
+        const std::size_t capacity_;
+
+        mutable std::mutex mutex_;
+        EntryList entries_;                                             // 앞쪽이 최근 사용
+        std::unordered_map<std::string, EntryList::iterator> by_key_;
+        std::unordered_map<int, std::vector<std::string>> keys_by_user_; // 사용자 ID -> 캐시 키 (무효화용)
+        std::uint64_t generation_ = 0;
+
+        std::atomic<std::uint64_t> hits_{ 0 };
+        std::atomic<std::uint64_t> misses_{ 0 };
+        std::atomic<std::uint64_t> evictions_{ 0 };
+        std::atomic<std::uint64_t> invalidations_{ 0 };
+    };
+
+} // namespace game_server
@@ -8,6 +8,7 @@
 namespace game_server {
 
     class DbPool;
+    class RoomStore;
 
     class GameRepository {
     public:
@@ -16,7 +17,7 @@ namespace game_server {
         virtual nlohmann::json createGame(const nlohmann::json& request) = 0;
         virtual nlohmann::json endGame(int roomId) = 0;
 
-        static std::unique_ptr<GameRepository> create(DbPool* dbPool);
+        static std::unique_ptr<GameRepository> create(DbPool* dbPool, std::shared_ptr<RoomStore> roomStore);
     };
 
 } // namespace game_server
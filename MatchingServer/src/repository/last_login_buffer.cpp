@@ -0,0 +1,77 @@
+﻿// repository/last_login_buffer.cpp
+// 마지막 로그인 시각 버퍼 구현 파일
+// 사용자 ID와 시각을 배열 파라미터로 묶어 unnest로 한 번에 갱신
+#include "last_login_buffer.h"
+#include "sql_statements.h"
+#include "../util/write_behind_queue.h"
+#include <chrono>
+#include <string>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    LastLoginBuffer::LastLoginBuffer(WriteBehindQueue* writeBehind)
+        : writeBehind_(writeBehind) {
+    }
+
+    LastLoginBuffer::~LastLoginBuffer() {
+        flush();
+    }
+
+    void LastLoginBuffer::record(int userId) {
+        if (userId <= 0) return;
+
+        auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_[userId] = now;
+        }
+        ++recorded_;
+    }
+
+    std::size_t LastLoginBuffer::flush() {
+        std::unordered_map<int, std::int64_t> batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (pending_.empty()) return 0;
+            batch.swap(pending_);
+        }
+
+        // PostgreSQL 배열 리터럴 ({1,2,3}) 형태로 파라미터 구성
+        std::string userIds = "{";
+        std::string loginTimes = "{";
+        userIds.reserve(batch.size() * 8 + 2);
+        loginTimes.reserve(batch.size() * 14 + 2);
+        for (const auto& [userId, loginMs] : batch) {
+            if (userIds.size() > 1) {
+                userIds += ',';
+                loginTimes += ',';
+            }
+            userIds += std::to_string(userId);
+            loginTimes += std::to_string(loginMs);
+        }
+        userIds += '}';
+        loginTimes += '}';
+
+        writeBehind_->enqueue({ WriteBehindQueue::statement(stmt::kUserUpdateLastLoginBatch, userIds, loginTimes) });
+
+        flushed_rows_ += batch.size();
+        ++flushes_;
+        spdlog::debug("마지막 로그인 시각 {}건 반영 요청", batch.size());
+        return batch.size();
+    }
+
+    LastLoginBuffer::Metrics LastLoginBuffer::getMetrics() const {
+        Metrics metrics;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            metrics.pending = pending_.size();
+        }
+        metrics.recorded = recorded_;
+        metrics.flushedRows = flushed_rows_;
+        metrics.flushes = flushes_;
+        return metrics;
+    }
+
+} // namespace game_server
@@ -0,0 +1,43 @@
+﻿// repository/last_login_buffer.h
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace game_server {
+
+    class WriteBehindQueue;
+
+    // 로그인 시각을 메모리에 모아 두었다가 주기적으로 한 번의 다중 행 UPDATE로 반영하는 버퍼
+    // 같은 사용자의 여러 로그인은 마지막 시각 하나로 합쳐짐
+    class LastLoginBuffer {
+    public:
+        struct Metrics {
+            std::size_t pending;
+            std::uint64_t recorded;
+            std::uint64_t flushedRows;
+            std::uint64_t flushes;
+        };
+
+        explicit LastLoginBuffer(WriteBehindQueue* writeBehind);
+        ~LastLoginBuffer();
+
+        void record(int userId);
+
+        // 모인 로그인 시각을 write-behind 큐에 넘기고 넘긴 행 수 반환
+        std::size_t flush();
+
+        Metrics getMetrics() const;
+
+    private:
+        WriteBehindQueue* writeBehind_;
+        mutable std::mutex mutex_;
+        std::unordered_map<int, std::int64_t> pending_; // 사용자 ID -> 마지막 로그인 시각 (epoch 밀리초)
+
+        std::atomic<std::uint64_t> recorded_{ 0 };
+        std::atomic<std::uint64_t> flushed_rows_{ 0 };
+        std::atomic<std::uint64_t> flushes_{ 0 };
+    };
+
+} // namespace game_server
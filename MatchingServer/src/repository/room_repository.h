@@ -1,5 +1,6 @@
 ﻿// repository/room_repository.h
 #pragma once
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <optional>
@@ -8,20 +9,33 @@
 
 namespace game_server {
 
-    class DbPool;
+    class RoomStore;
+
+    // 방 참가 결과 (실패 시 원인)
+    enum class JoinRoomResult {
+        Joined,
+        RoomNotFound,       // 존재하지 않는 방
+        NotWaiting,         // 게임 중이거나 종료된 방
+        AlreadyInRoom,      // 이미 이 방에 참가 중
+        InAnotherRoom,      // 다른 방에 참가 중
+        RoomFull            // 최대 인원 도달
+    };
 
     class RoomRepository {
     public:
         virtual ~RoomRepository() = default;
 
+        // 열린 방 목록, 각 방에 현재 인원(currentPlayers) 포함
         virtual std::vector<nlohmann::json> findAllOpen() = 0;
         virtual nlohmann::json createRoomWithHost(int hostId, const std::string& roomName, int maxPlayers) = 0;
-        virtual bool addPlayer(int roomId, int userId) = 0;
+        virtual JoinRoomResult addPlayer(int roomId, int userId) = 0;
         virtual bool removePlayer(int userId) = 0;
         virtual int getPlayerCount(int roomId) = 0;
         virtual std::vector<int> getPlayersInRoom(int roomId) = 0;
+        // 방 목록이 바뀔 때마다 증가하는 버전
+        virtual std::uint64_t getVersion() = 0;
 
-        static std::unique_ptr<RoomRepository> create(DbPool* dbPool);
+        static std::unique_ptr<RoomRepository> create(std::shared_ptr<RoomStore> roomStore);
     };
 
 } // namespace game_server
@@ -0,0 +1,27 @@
+﻿// repository/room_slot_allocator.cpp
+// 방 슬롯 할당기 구현 파일
+#include "room_slot_allocator.h"
+
+namespace game_server {
+
+    int RoomSlotAllocator::acquire() {
+        if (free_.empty()) return -1;
+        auto it = free_.begin();
+        int roomId = *it;
+        free_.erase(it);
+        return roomId;
+    }
+
+    void RoomSlotAllocator::release(int roomId) {
+        free_.insert(roomId);
+    }
+
+    void RoomSlotAllocator::clear() {
+        free_.clear();
+    }
+
+    std::size_t RoomSlotAllocator::available() const {
+        return free_.size();
+    }
+
+} // namespace game_server
@@ -0,0 +1,26 @@
+﻿// repository/room_slot_allocator.h
+#pragma once
+#include <cstddef>
+#include <set>
+
+namespace game_server {
+
+    // 종료(TERMINATED)된 방 슬롯 목록
+    // 방 ID마다 미러 서버 포트가 고정되어 있으므로 빈 슬롯을 가장 작은 방 ID부터 O(log n)에 할당
+    // 동기화는 호출하는 쪽(RoomStore)의 잠금에 맡김
+    class RoomSlotAllocator {
+    public:
+        // 빈 슬롯 중 가장 작은 방 ID를 꺼내 반환, 없으면 -1
+        int acquire();
+
+        // 방이 종료되어 다시 쓸 수 있게 된 슬롯 반환
+        void release(int roomId);
+
+        void clear();
+        std::size_t available() const;
+
+    private:
+        std::set<int> free_;
+    };
+
+} // namespace game_server
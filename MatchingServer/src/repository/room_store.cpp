@@ -0,0 +1,250 @@
+﻿// repository/room_store.cpp
+// 방 상태 메모리 테이블 구현 파일
+// 모든 변경은 잠금 안에서 메모리에 적용한 뒤 같은 순서로 write-behind 큐에 추가
+#include "room_store.h"
+#include "sql_statements.h"
+#include "../util/db_pool.h"
+#include "../util/query_stats.h"
+#include "../util/time_util.h"
+#include "../util/write_behind_queue.h"
+#include <algorithm>
+#include <pqxx/pqxx>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    using json = nlohmann::json;
+
+    RoomStore::RoomStore(DbPool* dbPool, WriteBehindQueue* writeBehind)
+        : dbPool_(dbPool), writeBehind_(writeBehind) {
+    }
+
+    void RoomStore::load() {
+        // 메모리 테이블의 기준이 되므로 복제 지연이 없는 기본 DB에서 읽음
+        auto conn = dbPool_->acquire(DbPool::Access::Write);
+        pqxx::read_transaction txn(*conn);
+        pqxx::result rooms = QueryStats::execPrepared(txn, stmt::kRoomLoadAll);
+        pqxx::result players = QueryStats::execPrepared(txn, stmt::kRoomUserLoadAll);
+        txn.commit();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        rooms_.clear();
+        user_rooms_.clear();
+        free_slots_.clear();
+
+        // 생성 시각 순으로 조회되므로 순서대로 번호를 붙여 목록 정렬에 사용
+        for (const auto& row : rooms) {
+            Room room;
+            room.roomId = row["room_id"].as<int>();
+            room.roomName = row["room_name"].as<std::string>();
+            room.hostId = row["host_id"].as<int>();
+            room.ipAddress = row["ip_address"].as<std::string>("");
+            room.port = row["port"].as<int>(0);
+            room.maxPlayers = row["max_players"].as<int>();
+            room.status = row["status"].as<std::string>();
+            room.createdAt = row["created_at"].as<std::string>("");
+            room.createdSeq = ++next_seq_;
+            if (room.status == "TERMINATED") {
+                free_slots_.release(room.roomId);
+            }
+            rooms_[room.roomId] = std::move(room);
+        }
+
+        for (const auto& row : players) {
+            int roomId = row["room_id"].as<int>();
+            int userId = row["user_id"].as<int>();
+            auto it = rooms_.find(roomId);
+            if (it == rooms_.end()) continue;
+            it->second.players.push_back(userId);
+            user_rooms_[userId] = roomId;
+        }
+
+        ++version_;
+        spdlog::info("방 정보 {}개, 참가자 {}명을 메모리에 불러왔습니다", rooms_.size(), user_rooms_.size());
+    }
+
+    std::vector<json> RoomStore::findAllOpen() {
+        std::vector<const Room*> open;
+        std::vector<json> result;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [roomId, room] : rooms_) {
+            if (room.status == "WAITING" || room.status == "GAME_IN_PROGRESS") {
+                open.push_back(&room);
+            }
+        }
+
+        // 최근 생성순
+        std::sort(open.begin(), open.end(), [](const Room* a, const Room* b) {
+            return a->createdSeq > b->createdSeq;
+            });
+
+        result.reserve(open.size());
+        for (const Room* room : open) {
+            json item;
+            item["roomId"] = room->roomId;
+            item["roomName"] = room->roomName;
+            item["hostId"] = room->hostId;
+            item["ipAddress"] = room->ipAddress;
+            item["port"] = room->port;
+            item["maxPlayers"] = room->maxPlayers;
+            item["status"] = room->status;
+            item["createdAt"] = room->createdAt;
+            item["currentPlayers"] = room->players.size();
+            result.push_back(std::move(item));
+        }
+        return result;
+    }
+
+    json RoomStore::createRoomWithHost(int hostId, const std::string& roomName, int maxPlayers) {
+        json result = {
+            {"roomId", -1}
+        };
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (user_rooms_.count(hostId)) {
+            return result;
+        }
+
+        // 유효한 방 ID 찾기 (종료된 방 중 가장 작은 ID)
+        int roomId = free_slots_.acquire();
+        if (roomId < 0) {
+            return result;
+        }
+
+        // 방 재활성화 및 사용자를 방에 추가
+        Room& room = rooms_[roomId];
+        room.roomName = roomName;
+        room.hostId = hostId;
+        room.maxPlayers = maxPlayers;
+        room.status = "WAITING";
+        room.createdAt = TimeUtil::currentTimestamp();
+        room.createdSeq = ++next_seq_;
+        room.players.assign(1, hostId);
+        user_rooms_[hostId] = room.roomId;
+        ++version_;
+
+        writeBehind_->enqueue({
+            WriteBehindQueue::statement(stmt::kRoomReactivate, roomName, hostId, maxPlayers, room.roomId),
+            WriteBehindQueue::statement(stmt::kRoomUserInsert, room.roomId, hostId)
+            });
+
+        result["roomId"] = room.roomId;
+        result["roomName"] = room.roomName;
+        result["ipAddress"] = room.ipAddress;
+        result["port"] = room.port;
+        result["maxPlayers"] = room.maxPlayers;
+        return result;
+    }
+
+    JoinRoomResult RoomStore::addPlayer(int roomId, int userId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // 방이 존재하고 WAITING 상태인지 확인
+        auto it = rooms_.find(roomId);
+        if (it == rooms_.end()) {
+            spdlog::error("방 {}이(가) 존재하지 않습니다", roomId);
+            return JoinRoomResult::RoomNotFound;
+        }
+
+        Room& room = it->second;
+        if (room.status != "WAITING") {
+            spdlog::error("방 {}에 참가할 수 없습니다 - 상태가 {}입니다", roomId, room.status);
+            return JoinRoomResult::NotWaiting;
+        }
+
+        // 이미 참가한 사용자인지 확인 (사용자는 한 번에 한 방에만 참가)
+        auto user_it = user_rooms_.find(userId);
+        if (user_it != user_rooms_.end()) {
+            if (user_it->second == roomId) {
+                spdlog::error("사용자 {}는 이미 방 {}에 있습니다", userId, roomId);
+                return JoinRoomResult::AlreadyInRoom;
+            }
+            spdlog::error("사용자 {}는 다른 방 {}에 참가 중입니다", userId, user_it->second);
+            return JoinRoomResult::InAnotherRoom;
+        }
+
+        // 최대 인원 확인
+        int currentPlayers = static_cast<int>(room.players.size());
+        if (currentPlayers >= room.maxPlayers) {
+            spdlog::error("방 {}이(가) 가득 찼습니다 ({}/{})", roomId, currentPlayers, room.maxPlayers);
+            return JoinRoomResult::RoomFull;
+        }
+
+        // 새 참가자 추가
+        room.players.push_back(userId);
+        user_rooms_[userId] = roomId;
+        ++version_;
+        writeBehind_->enqueue({ WriteBehindQueue::statement(stmt::kRoomUserInsert, roomId, userId) });
+
+        spdlog::debug("사용자 {}이(가) 방 {}에 참가했습니다", userId, roomId);
+        return JoinRoomResult::Joined;
+    }
+
+    bool RoomStore::removePlayer(int userId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // 사용자가 속한 방 ID 가져오기
+        auto user_it = user_rooms_.find(userId);
+        if (user_it == user_rooms_.end()) {
+            spdlog::warn("사용자 {}은(는) 어떤 방에도 없습니다", userId);
+            return false;
+        }
+
+        int roomId = user_it->second;
+        user_rooms_.erase(user_it);
+
+        // 참가자 제거
+        Room& room = rooms_[roomId];
+        room.players.erase(std::remove(room.players.begin(), room.players.end(), userId), room.players.end());
+        std::vector<WriteBehindQueue::Statement> statements{
+            WriteBehindQueue::statement(stmt::kRoomUserDelete, userId)
+        };
+
+        // 방에 남은 플레이어가 없으면 방 상태 TERMINATED로 변경하고 진행 중 게임도 완료 처리
+        int remaining_players = static_cast<int>(room.players.size());
+        if (remaining_players == 0) {
+            room.status = "TERMINATED";
+            free_slots_.release(roomId);
+            statements.push_back(WriteBehindQueue::statement(stmt::kRoomTerminate, roomId));
+            statements.push_back(WriteBehindQueue::statement(stmt::kGameCompleteInRoom, roomId));
+            spdlog::debug("방 {}이(가) 종료 처리되었습니다 (남은 플레이어 없음), 해당 방의 진행 중 게임들도 완료 처리: {}", roomId, roomId);
+        }
+        ++version_;
+        writeBehind_->enqueue(std::move(statements));
+
+        spdlog::debug("사용자 {}이(가) 방 {}을(를) 나갔습니다, 남은 플레이어 {}명",
+            userId, roomId, remaining_players);
+        return true;
+    }
+
+    int RoomStore::getPlayerCount(int roomId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = rooms_.find(roomId);
+        return it == rooms_.end() ? 0 : static_cast<int>(it->second.players.size());
+    }
+
+    std::vector<int> RoomStore::getPlayersInRoom(int roomId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = rooms_.find(roomId);
+        if (it == rooms_.end()) return {};
+        return it->second.players;
+    }
+
+    bool RoomStore::markInProgress(int roomId, std::vector<int>& players) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = rooms_.find(roomId);
+        if (it == rooms_.end()) return false;
+
+        it->second.status = "GAME_IN_PROGRESS";
+        ++version_;
+        players = it->second.players;
+        writeBehind_->enqueue({ WriteBehindQueue::statement(stmt::kRoomMarkInProgress, roomId) });
+        return true;
+    }
+
+    std::uint64_t RoomStore::getVersion() const {
+        return version_.load();
+    }
+
+} // namespace game_server
@@ -0,0 +1,67 @@
+﻿// repository/room_store.h
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "room_repository.h"
+#include "room_slot_allocator.h"
+
+namespace game_server {
+
+    class DbPool;
+    class WriteBehindQueue;
+
+    // 방과 참가자 상태의 기준이 되는 메모리 테이블
+    // 조회/변경은 메모리에서 바로 처리하고 rooms, room_users 테이블에는 write-behind 큐로 순서대로 반영
+    class RoomStore {
+    public:
+        RoomStore(DbPool* dbPool, WriteBehindQueue* writeBehind);
+
+        // 시작 시 DB의 방/참가자 정보로 메모리 테이블 재구성
+        void load();
+
+        // 열린 방 목록 (최근 생성순, 현재 인원 포함)
+        std::vector<nlohmann::json> findAllOpen();
+        nlohmann::json createRoomWithHost(int hostId, const std::string& roomName, int maxPlayers);
+        // 참가 조건 확인과 추가를 한 번의 잠금 안에서 처리하고 실패 원인 반환
+        JoinRoomResult addPlayer(int roomId, int userId);
+        bool removePlayer(int userId);
+        int getPlayerCount(int roomId);
+        std::vector<int> getPlayersInRoom(int roomId);
+
+        // 게임 시작 시 방 상태 변경, 방이 없으면 false
+        bool markInProgress(int roomId, std::vector<int>& players);
+
+        // 방 목록에 영향을 주는 변경마다 증가하는 버전 (목록 캐시 무효화용)
+        std::uint64_t getVersion() const;
+
+    private:
+        struct Room {
+            int roomId = 0;
+            std::string roomName;
+            int hostId = 0;
+            std::string ipAddress;
+            int port = 0;
+            int maxPlayers = 0;
+            std::string status;
+            std::string createdAt;
+            std::uint64_t createdSeq = 0;  // 생성 순서 (목록 정렬용)
+            std::vector<int> players;
+        };
+
+        DbPool* dbPool_;
+        WriteBehindQueue* writeBehind_;
+        std::mutex mutex_;
+        std::map<int, Room> rooms_;                 // 방 ID 순
+        RoomSlotAllocator free_slots_;              // 종료된 방 ID (빈 방 재사용 시 가장 작은 ID 우선)
+        std::unordered_map<int, int> user_rooms_;   // 사용자 ID -> 참가 중인 방 ID
+        std::uint64_t next_seq_ = 0;
+        std::atomic<std::uint64_t> version_{ 0 };
+    };
+
+} // namespace game_server
@@ -0,0 +1,93 @@
+﻿// repository/sql_statements.cpp
+// prepared statement 카탈로그 구현 파일
+// 연결마다 한 번만 파싱/계획하도록 모든 리포지토리 쿼리를 이름으로 등록
+#include "sql_statements.h"
+#include <pqxx/pqxx>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    namespace {
+
+        struct StatementDef {
+            const char* name;
+            const char* sql;
+        };
+
+        const StatementDef kCatalog[] = {
+            // 사용자
+            { stmt::kUserFindByName,
+                "SELECT user_id, user_name, password_hash, nick_name, created_at, last_login "
+                "FROM users WHERE LOWER(user_name) = LOWER($1)" },
+            { stmt::kUserCreate,
+                "INSERT INTO users (user_name, password_hash) "
+                "VALUES ($1, $2) RETURNING user_id" },
+            { stmt::kUserUpdateLastLoginBatch,
+                "UPDATE users AS u SET last_login = to_timestamp(v.login_ms / 1000.0) "
+                "FROM unnest($1::int[], $2::bigint[]) AS v(user_id, login_ms) "
+                "WHERE u.user_id = v.user_id" },
+            { stmt::kUserUpdateNickName,
+                "UPDATE users SET nick_name = $2 "
+                "WHERE user_id = $1 "
+                "RETURNING user_id" },
+
+            // 방
+            { stmt::kRoomLoadAll,
+                "SELECT room_id, room_name, host_id, ip_address, port, "
+                "max_players, status, created_at "
+                "FROM rooms ORDER BY created_at, room_id" },
+            { stmt::kRoomUserLoadAll,
+                "SELECT room_id, user_id FROM room_users ORDER BY joined_at" },
+            { stmt::kRoomReactivate,
+                "UPDATE rooms SET room_name = $1, host_id = $2, max_players = $3, "
+                "status = 'WAITING', created_at = DEFAULT "
+                "WHERE room_id = $4 AND status = 'TERMINATED' "
+                "RETURNING room_id, room_name, ip_address, port, max_players" },
+            { stmt::kRoomMarkInProgress,
+                "UPDATE rooms "
+                "SET status = 'GAME_IN_PROGRESS' "
+                "WHERE room_id = $1 "
+                "RETURNING status" },
+            { stmt::kRoomTerminate,
+                "UPDATE rooms SET status = 'TERMINATED' WHERE room_id = $1" },
+            { stmt::kRoomUserInsert,
+                "INSERT INTO room_users (room_id, user_id, joined_at) "
+                "VALUES ($1, $2, DEFAULT) "
+                "ON CONFLICT (room_id, user_id) DO NOTHING" },
+            { stmt::kRoomUserDelete,
+                "DELETE FROM room_users WHERE user_id = $1" },
+
+            // 게임
+            { stmt::kGameCreate,
+                "INSERT INTO games (room_id, map_id) "
+                "VALUES ($1, $2) "
+                "RETURNING game_id" },
+            { stmt::kGameComplete,
+                "UPDATE games "
+                "SET status = 'COMPLETED', completed_at = CURRENT_TIMESTAMP "
+                "WHERE game_id = $1 "
+                "RETURNING room_id" },
+            { stmt::kGameCompleteInRoom,
+                "UPDATE games SET status = 'COMPLETED', completed_at = CURRENT_TIMESTAMP "
+                "WHERE status = 'IN_PROGRESS' AND room_id = $1" },
+        };
+
+    } // namespace
+
+    void prepareStatements(pqxx::connection& conn) {
+        for (const auto& def : kCatalog) {
+            conn.prepare(def.name, def.sql);
+        }
+        spdlog::debug("prepared statement {}개 등록 완료", std::size(kCatalog));
+    }
+
+    std::vector<std::pair<std::string, std::string>> statementCatalog() {
+        std::vector<std::pair<std::string, std::string>> catalog;
+        catalog.reserve(std::size(kCatalog));
+        for (const auto& def : kCatalog) {
+            catalog.emplace_back(def.name, def.sql);
+        }
+        return catalog;
+    }
+
+} // namespace game_server
@@ -0,0 +1,43 @@
+﻿// repository/sql_statements.h
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pqxx {
+    class connection;
+}
+
+namespace game_server {
+
+    // 리포지토리에서 사용하는 prepared statement 이름
+    // 실제 SQL은 sql_statements.cpp의 카탈로그 한 곳에서 관리
+    namespace stmt {
+        // 사용자
+        inline constexpr const char* kUserFindByName = "user_find_by_name";
+        inline constexpr const char* kUserCreate = "user_create";
+        inline constexpr const char* kUserUpdateLastLoginBatch = "user_update_last_login_batch";
+        inline constexpr const char* kUserUpdateNickName = "user_update_nick_name";
+
+        // 방 (RoomStore의 시작 시 적재와 write-behind 기록)
+        inline constexpr const char* kRoomLoadAll = "room_load_all";
+        inline constexpr const char* kRoomUserLoadAll = "room_user_load_all";
+        inline constexpr const char* kRoomReactivate = "room_reactivate";
+        inline constexpr const char* kRoomMarkInProgress = "room_mark_in_progress";
+        inline constexpr const char* kRoomTerminate = "room_terminate";
+        inline constexpr const char* kRoomUserInsert = "room_user_insert";
+        inline constexpr const char* kRoomUserDelete = "room_user_delete";
+
+        // 게임
+        inline constexpr const char* kGameCreate = "game_create";
+        inline constexpr const char* kGameComplete = "game_complete";
+        inline constexpr const char* kGameCompleteInRoom = "game_complete_in_room";
+    }
+
+    // 카탈로그의 모든 문장을 연결에 준비 (DbPool 연결 초기화 훅, 생성/재연결 시 호출)
+    void prepareStatements(pqxx::connection& conn);
+
+    // 카탈로그 전체 (이름, SQL) 목록, libpq 비동기 연결에서 직접 준비할 때 사용
+    std::vector<std::pair<std::string, std::string>> statementCatalog();
+
+} // namespace game_server
@@ -9,18 +9,22 @@
 namespace game_server {
 
     class DbPool;
+    class LastLoginBuffer;
 
     class UserRepository {
     public:
         virtual ~UserRepository() = default;
 
         //virtual std::optional<nlohmann::json> findById(int userId) = 0;
+        // 읽기 전용 복제본에서 조회할 수 있으므로 방금 쓴 데이터가 보이지 않을 수 있음
         virtual nlohmann::json findByUsername(const std::string& username) = 0;
+        // 방금 생성/변경한 사용자를 다시 읽을 때 사용 (기본 DB에서 조회)
+        virtual nlohmann::json findByUsernameFromPrimary(const std::string& username) = 0;
         virtual int create(const std::string& username, const std::string& hashedPassword) = 0;
         virtual bool updateLastLogin(int userId) = 0;
         virtual bool updateUserNickName(int userId, const std::string& nickName) = 0;
 
-        static std::unique_ptr<UserRepository> create(DbPool* dbPool);
+        static std::unique_ptr<UserRepository> create(DbPool* dbPool, LastLoginBuffer* lastLoginBuffer);
     };
 
 } // namespace game_server
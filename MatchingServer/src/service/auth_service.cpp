@@ -2,91 +2,21 @@
 // 인증 서비스 구현 파일
 // 사용자 등록 및 로그인 비즈니스 로직을 처리
 #include "auth_service.h"
-#include "../util/password_util.h"
+#include "../util/input_validator.h"
+#include "../util/password_hasher.h"
 #include "../repository/user_repository.h"
 #include <spdlog/spdlog.h>
-#include <regex>
+#include <optional>
 
 namespace game_server {
 
     using json = nlohmann::json;
 
-    namespace {
-        // 사용자 이름 유효성 검증 함수
-        bool isValidUserName(const std::string& name) {
-            // 빈 이름은 유효하지 않음
-            if (name.empty()) {
-                return false;
-            }
-
-            // 30바이트 이내인지 확인
-            if (name.size() > 30) {
-                return false;
-            }
-
-            // "mirror" 단어가 포함되어 있는지 확인 (대소문자 구분 없이)
-            if (name.find("mirror") != std::string::npos) {
-                return false;
-            }
-
-            // 이메일 형식인지 확인
-            bool isEmail = (name.find('@') != std::string::npos) &&
-                (name.find('.', name.find('@')) != std::string::npos);
-
-            // 이메일이 아닌 경우 영어, 한글, 숫자, @ 문자만 포함하는지 확인
-            if (!isEmail) {
-                for (unsigned char c : name) {
-                    // ASCII 영어와 숫자 확인
-                    if ((c >= 'A' && c <= 'Z') ||
-                        (c >= 'a' && c <= 'z') ||
-                        (c >= '0' && c <= '9')) {
-                        continue;
-                    }
-
-                    // 허용되지 않는 문자
-                    return false;
-                }
-            }
-            else {
-                // 이메일인 경우 추가 검증 (간단한 이메일 형식 검사)
-                // 여기서는 표준적인 이메일 문자들(영어, 숫자, 일부 특수문자) 허용
-                for (unsigned char c : name) {
-                    if ((c >= 'A' && c <= 'Z') ||
-                        (c >= 'a' && c <= 'z') ||
-                        (c >= '0' && c <= '9') ||
-                        (c == '@') || (c == '.') ||
-                        (c == '_') || (c == '-') || (c == '+')) {
-                        continue;
-                    }
-
-                    // 이메일에 한글은 허용하지 않음 (IDN 이메일 제외)
-                    return false;
-                }
-            }
-
-            return true;
-        }
-
-        bool isValidNickName(const std::string& str) {
-            // 정규식 패턴: 한글(가-힣), 영어(A-Za-z), 숫자(0-9)만 허용
-            if (str.size() > 24) return false;
-
-            try {
-                std::regex pattern("^[가-힣A-Za-z0-9]+$");
-                return std::regex_match(str, pattern);
-            }
-            catch (const std::regex_error& e) {
-                spdlog::error("닉네임 {}에 대한 검증 시 정규식 오류 발생 : {}",str,  e.what());
-                return false;
-            }
-        }
-    }
-
     // 서비스 구현체
     class AuthServiceImpl : public AuthService {
     public:
-        explicit AuthServiceImpl(std::shared_ptr<UserRepository> userRepo)
-            : userRepo_(userRepo) {
+        AuthServiceImpl(std::shared_ptr<UserRepository> userRepo, PasswordHasher* hasher)
+            : userRepo_(userRepo), hasher_(hasher) {
         }
 
         json registerUser(const json& request) override {
@@ -99,7 +29,7 @@ namespace game_server {
                 return response;
             }
 
-            if (!isValidUserName(request["userName"])) {
+            if (!InputValidator::isValidUserName(request["userName"].get_ref<const std::string&>())) {
                 response["status"] = "error";
                 response["message"] = "잘못된 형식의 아이디입니다.";
                 return response;
@@ -120,11 +50,14 @@ namespace game_server {
                 return response;
             }
 
-            // PasswordUtil을 사용하여 비밀번호 해싱
-            std::string hashedPassword = PasswordUtil::hashPassword(request["password"]);
+            // 해싱 전용 스레드에서 비밀번호 해싱
+            auto hashedPassword = hashPassword(request["password"]);
+            if (!hashedPassword) {
+                return busyResponse();
+            }
 
             // 새 사용자 생성
-            int userId = userRepo_->create(request["userName"], hashedPassword);
+            int userId = userRepo_->create(request["userName"], *hashedPassword);
             if (userId < 0) {
                 response["status"] = "error";
                 response["message"] = "회원가입에 실패하였습니다.";
@@ -160,8 +93,12 @@ namespace game_server {
                 return response;
             }
 
-            // PasswordUtil을 사용하여 비밀번호 검증
-            if (!PasswordUtil::verifyPassword(request["password"], userInfo["passwordHash"])) {
+            // 해싱 전용 스레드에서 비밀번호 검증
+            auto verified = verifyPassword(request["password"], userInfo["passwordHash"]);
+            if (!verified) {
+                return busyResponse();
+            }
+            if (!*verified) {
                 response["status"] = "error";
                 response["message"] = "비밀번호가 일치하지 않습니다.";
                 return response;
@@ -196,23 +133,28 @@ namespace game_server {
             json userInfo = userRepo_->findByUsername(request["userName"]);
             int userId = -1;
             if (userInfo["userId"] == -1) {
-                // PasswordUtil을 사용하여 비밀번호 해싱
-                std::string hashedPassword = PasswordUtil::hashPassword(request["password"]);
+                // 해싱 전용 스레드에서 비밀번호 해싱
+                auto hashedPassword = hashPassword(request["password"]);
+                if (!hashedPassword) {
+                    return busyResponse();
+                }
 
                 // 새 사용자 생성
-                userId = userRepo_->create(request["userName"], hashedPassword);
+                userId = userRepo_->create(request["userName"], *hashedPassword);
                 if (userId < 0) {
                     response["status"] = "error";
                     response["message"] = "사용재 생성에 실패하였습니다.";
                     spdlog::error("새로운 사용자를 생성하는 도중 에러가 발생하였습니다.");
                     return response;
                 }
+
+                // 방금 생성한 사용자는 복제본/캐시에 아직 없으므로 기본 DB에서 다시 조회
+                // 기존 사용자는 위의 (캐시) 조회 결과를 그대로 사용해 로그인마다 DB를 다시 읽지 않음
+                userInfo = userRepo_->findByUsernameFromPrimary(request["userName"]);
             }
 
-            userInfo = userRepo_->findByUsername(request["userName"]);
-            
-            // 로그인 시간 업데이트
-            userRepo_->updateLastLogin(userId);
+            // 로그인 시간 업데이트 (기존 사용자는 조회한 ID 사용)
+            userRepo_->updateLastLogin(userInfo["userId"]);
 
             // 성공 응답 생성
             response["action"] = "login";
@@ -236,7 +178,7 @@ namespace game_server {
                 return response;
             }
 
-            if (!isValidNickName(request["nickName"])) {
+            if (!InputValidator::isValidNickName(request["nickName"].get_ref<const std::string&>())) {
                 response["status"] = "error";
                 response["message"] = "잘못된 형식의 닉네임입니다.";
                 return response;
@@ -259,12 +201,41 @@ namespace game_server {
         }
 
     private:
+        // 해싱 풀에 맡기고 결과를 기다림, 해싱 대기열이 가득 차면 nullopt
+        std::optional<std::string> hashPassword(const std::string& password) {
+            try {
+                return hasher_->hashAsync(password).get();
+            }
+            catch (const PasswordHasherBusy& e) {
+                spdlog::warn("{}", e.what());
+                return std::nullopt;
+            }
+        }
+
+        std::optional<bool> verifyPassword(const std::string& password, const std::string& hashedPassword) {
+            try {
+                return hasher_->verifyAsync(password, hashedPassword).get();
+            }
+            catch (const PasswordHasherBusy& e) {
+                spdlog::warn("{}", e.what());
+                return std::nullopt;
+            }
+        }
+
+        static json busyResponse() {
+            return {
+                {"status", "error"},
+                {"message", "서버가 혼잡합니다. 잠시 후 다시 시도해주세요"}
+            };
+        }
+
         std::shared_ptr<UserRepository> userRepo_;
+        PasswordHasher* hasher_;
     };
 
     // 팩토리 메서드 구현
-    std::unique_ptr<AuthService> AuthService::create(std::shared_ptr<UserRepository> userRepo) {
-        return std::make_unique<AuthServiceImpl>(userRepo);
+    std::unique_ptr<AuthService> AuthService::create(std::shared_ptr<UserRepository> userRepo, PasswordHasher* hasher) {
+        return std::make_unique<AuthServiceImpl>(userRepo, hasher);
     }
 
 } // namespace game_server
\ No newline at end of file
@@ -6,6 +6,7 @@
 namespace game_server {
 
     class UserRepository;
+    class PasswordHasher;
 
     class AuthService {
     public:
@@ -16,7 +17,7 @@ namespace game_server {
         virtual nlohmann::json registerCheckAndLogin(const nlohmann::json& request) = 0;
         virtual nlohmann::json updateNickName(const nlohmann::json& request) = 0;
 
-        static std::unique_ptr<AuthService> create(std::shared_ptr<UserRepository> userRepo);
+        static std::unique_ptr<AuthService> create(std::shared_ptr<UserRepository> userRepo, PasswordHasher* hasher);
     };
 
 } // namespace game_server
@@ -1,7 +1,9 @@
 ﻿#include "room_service.h"
 #include "../repository/room_repository.h"
+#include "../util/input_validator.h"
 #include <spdlog/spdlog.h>
 #include <random>
+#include <mutex>
 #include <string>
 #include <nlohmann/json.hpp>
 
@@ -10,47 +12,27 @@ namespace game_server {
     using json = nlohmann::json;
 
     namespace {
-        // 방 이름 유효성 검증 함수
-        bool isValidRoomName(const std::string& name) {
-            // 빈 이름은 유효하지 않음
-            if (name.empty()) {
-                return false;
+        // 방 참가 실패 원인 코드 (클라이언트 분기용)
+        const char* joinFailureReason(JoinRoomResult result) {
+            switch (result) {
+            case JoinRoomResult::RoomNotFound: return "ROOM_NOT_FOUND";
+            case JoinRoomResult::NotWaiting: return "NOT_WAITING";
+            case JoinRoomResult::AlreadyInRoom: return "ALREADY_IN_ROOM";
+            case JoinRoomResult::InAnotherRoom: return "IN_ANOTHER_ROOM";
+            case JoinRoomResult::RoomFull: return "ROOM_FULL";
+            default: return "UNKNOWN";
             }
+        }
 
-            // 40바이트(UTF-8 표준) 이내인지 확인
-            if (name.size() > 40) {
-                return false;
-            }
-
-            // 영어, 한글, 숫자만 포함하는지 확인
-            int len = name.size();
-            for (int i = 0; i < len; ++i) {
-                // ASCII 영어와 숫자 확인
-                const char& c = name[i];
-                if (i == len - 1 && c == '$') continue;
-                if ((c >= 'A' && c <= 'Z') ||
-                    (c >= 'a' && c <= 'z') ||
-                    (c >= '0' && c <= '9') ||
-                    (c == ' ')) {
-                    continue;
-                }
-
-                // UTF-8 한글 범위 확인 (첫 바이트가 0xEA~0xED 범위)
-                if ((c & 0xF0) == 0xE0) {
-                    // 한글 문자의 첫 바이트 가능성, 좀 더 정확한 확인 필요
-                    continue;
-                }
-
-                // 한글 문자의 연속 바이트 (0x80~0xBF 범위)
-                if ((c & 0xC0) == 0x80) {
-                    continue;
-                }
-
-                // 허용되지 않는 문자
-                return false;
+        const char* joinFailureMessage(JoinRoomResult result) {
+            switch (result) {
+            case JoinRoomResult::RoomNotFound: return "방 참가에 실패했습니다 - 존재하지 않는 방입니다";
+            case JoinRoomResult::NotWaiting: return "방 참가에 실패했습니다 - 이미 게임이 시작되었거나 종료된 방입니다";
+            case JoinRoomResult::AlreadyInRoom: return "방 참가에 실패했습니다 - 이미 참가한 방입니다";
+            case JoinRoomResult::InAnotherRoom: return "방 참가에 실패했습니다 - 다른 방에 참가 중입니다";
+            case JoinRoomResult::RoomFull: return "방 참가에 실패했습니다 - 방이 가득 찼습니다";
+            default: return "방 참가에 실패했습니다";
             }
-
-            return true;
         }
     }
 
@@ -72,7 +54,7 @@ namespace game_server {
                     return response;
                 }
 
-                if (!isValidRoomName(request["roomName"])) {
+                if (!InputValidator::isValidRoomName(request["roomName"].get_ref<const std::string&>())) {
                     response["status"] = "error";
                     response["message"] = "방 이름은 1-40바이트 길이여야 하며 영어, 한글, 숫자만 포함해야 합니다";
                     return response;
@@ -129,10 +111,12 @@ namespace game_server {
                 int roomId = request["roomId"];
                 int userId = request["userId"];
 
-                // 방에 참가자 추가
-                if (!roomRepo_->addPlayer(roomId, userId)) {
+                // 방에 참가자 추가 (실패 시 원인별 메시지)
+                JoinRoomResult result = roomRepo_->addPlayer(roomId, userId);
+                if (result != JoinRoomResult::Joined) {
                     response["status"] = "error";
-                    response["message"] = "방 참가에 실패했습니다 - 방이 가득 찼거나 WAITING 상태가 아닙니다";
+                    response["reason"] = joinFailureReason(result);
+                    response["message"] = joinFailureMessage(result);
                     return response;
                 }
 
@@ -189,11 +173,32 @@ namespace game_server {
             return response;
         }
 
+        std::shared_ptr<const EncodedMessage> listRoomsEncoded() override {
+            // 방 목록이 바뀌지 않았으면 캐시된 응답 반환 (로비 폴링은 대부분 여기서 처리, 복사/직렬화 없음)
+            std::uint64_t version = roomRepo_->getVersion();
+            {
+                std::lock_guard<std::mutex> lock(list_cache_mutex_);
+                if (list_cache_ && list_cache_version_ == version) {
+                    return list_cache_;
+                }
+            }
+
+            json response = listRooms();
+            auto encoded = std::make_shared<const EncodedMessage>(std::move(response));
+            if (encoded->message()["status"] == "success") {
+                // 조회 전에 읽은 버전으로 저장하므로 조회 중 변경이 있었다면 다음 요청에서 다시 조회
+                std::lock_guard<std::mutex> lock(list_cache_mutex_);
+                list_cache_ = encoded;
+                list_cache_version_ = version;
+            }
+            return encoded;
+        }
+
         json listRooms() override {
             json response;
 
             try {
-                // 열린 방 목록 가져오기
+                // 현재 인원이 포함된 열린 방 목록을 한 번에 가져오기
                 auto rooms = roomRepo_->findAllOpen();
 
                 // 응답 생성
@@ -203,8 +208,7 @@ namespace game_server {
                 response["rooms"] = json::array();
 
                 for (auto& room : rooms) {
-                    room["currentPlayers"] = roomRepo_->getPlayerCount(room["roomId"]);
-                    response["rooms"].push_back(room);
+                    response["rooms"].push_back(std::move(room));
                 }
 
                 spdlog::debug("{}개의 열린 방을 조회했습니다", response["rooms"].size());
@@ -220,6 +224,11 @@ namespace game_server {
 
     private:
         std::shared_ptr<RoomRepository> roomRepo_;
+
+        // listRooms 응답 캐시 (방 목록 버전이 바뀌면 무효)
+        std::mutex list_cache_mutex_;
+        std::shared_ptr<const EncodedMessage> list_cache_;
+        std::uint64_t list_cache_version_ = 0;
     };
 
     // 팩토리 메서드 구현
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <nlohmann/json.hpp>
+#include "../core/wire_codec.h"
 
 namespace game_server {
 
@@ -17,6 +18,8 @@ namespace game_server {
         virtual nlohmann::json joinRoom(nlohmann::json& request) = 0;
         virtual nlohmann::json exitRoom(nlohmann::json& request) = 0;
         virtual nlohmann::json listRooms() = 0;
+        // 방 목록이 바뀌기 전까지 같은 응답 객체를 반환 (인코딩별 송신 버퍼도 한 번만 만들어 공유)
+        virtual std::shared_ptr<const EncodedMessage> listRoomsEncoded() = 0;
 
         static std::unique_ptr<RoomService> create(std::shared_ptr<RoomRepository> roomRepo);
     };
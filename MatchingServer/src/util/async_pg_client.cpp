@@ -0,0 +1,467 @@
+﻿// util/async_pg_client.cpp
+// 비동기 PostgreSQL 클라이언트 구현 파일
+// 모든 상태는 스트랜드에서만 다루며, libpq 소켓은 asio 소켓에 등록해 이벤트만 기다림
+#include "async_pg_client.h"
+#include <libpq-fe.h>
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    namespace {
+
+        // 같은 묶음을 다시 보내면 성공할 수 있는 오류 (직렬화 실패, 교착 상태)
+        bool isTransientError(const PGresult* res) {
+            const char* state = PQresultErrorField(res, PG_DIAG_SQLSTATE);
+            return state && (std::strcmp(state, "40001") == 0 || std::strcmp(state, "40P01") == 0);
+        }
+
+    } // namespace
+
+    AsyncPgClient::AsyncPgClient(boost::asio::io_context& io_context, std::string connectionString, Catalog catalog)
+        : strand_(boost::asio::make_strand(io_context)),
+        socket_(strand_),
+        reconnect_timer_(strand_),
+        connection_string_(std::move(connectionString)),
+        catalog_(std::move(catalog))
+    {
+    }
+
+    AsyncPgClient::~AsyncPgClient() {
+        release_socket();
+        if (conn_) {
+            PQfinish(conn_);
+        }
+    }
+
+    void AsyncPgClient::start() {
+        boost::asio::post(strand_, [self = shared_from_this()]() {
+            self->connect();
+            });
+    }
+
+    void AsyncPgClient::execute(std::vector<Statement> statements, Callback callback) {
+        Unit unit;
+        unit.statements = std::move(statements);
+        unit.callback = std::move(callback);
+        ++submitted_;
+
+        boost::asio::post(strand_, [self = shared_from_this(), unit = std::move(unit)]() mutable {
+            if (self->closed_) {
+                unit.result.ok = false;
+                unit.result.error = "연결이 종료된 클라이언트";
+                ++self->failed_;
+                if (unit.callback) unit.callback(std::move(unit.result));
+                return;
+            }
+            self->pending_.push_back(std::move(unit));
+            ++self->queued_count_;
+            self->pump();
+            });
+    }
+
+    void AsyncPgClient::async_drain(std::function<void()> handler) {
+        boost::asio::post(strand_, [self = shared_from_this(), handler = std::move(handler)]() mutable {
+            self->drain_handlers_.push_back(std::move(handler));
+            self->check_drained();
+            });
+    }
+
+    void AsyncPgClient::close() {
+        boost::asio::post(strand_, [self = shared_from_this()]() {
+            self->closed_ = true;
+            self->connected_ = false;
+            ++self->generation_;
+            self->reconnect_timer_.cancel();
+            self->release_socket();
+            if (self->conn_) {
+                PQfinish(self->conn_);
+                self->conn_ = nullptr;
+            }
+
+            // 남은 묶음은 실패로 완료
+            std::deque<Unit> remaining;
+            remaining.swap(self->in_flight_);
+            for (auto& unit : self->pending_) {
+                remaining.push_back(std::move(unit));
+            }
+            self->pending_.clear();
+            self->queued_count_ = 0;
+            self->in_flight_count_ = 0;
+            for (auto& unit : remaining) {
+                if (unit.internal) continue;
+                ++self->failed_;
+                unit.result.ok = false;
+                unit.result.error = "연결 종료로 실행하지 못함";
+                if (unit.callback) unit.callback(std::move(unit.result));
+            }
+            self->check_drained();
+            });
+    }
+
+    void AsyncPgClient::connect() {
+        if (closed_) return;
+
+        ++generation_;
+        conn_ = PQconnectStart(connection_string_.c_str());
+        if (!conn_ || PQstatus(conn_) == CONNECTION_BAD) {
+            handle_connection_error(conn_ ? PQerrorMessage(conn_) : "연결 생성 실패");
+            return;
+        }
+
+        // PQconnectStart 직후에는 쓰기 가능 상태를 기다린 뒤 PQconnectPoll 호출
+        assign_socket();
+        poll_connect(false);
+    }
+
+    void AsyncPgClient::poll_connect(bool wait_for_read) {
+        auto self = shared_from_this();
+        auto generation = generation_;
+        socket_.async_wait(
+            wait_for_read ? boost::asio::socket_base::wait_read : boost::asio::socket_base::wait_write,
+            boost::asio::bind_executor(strand_, [this, self, generation](const boost::system::error_code& ec) {
+                if (generation != generation_ || closed_) return;
+                if (ec) {
+                    handle_connection_error("연결 대기 오류: " + ec.message());
+                    return;
+                }
+
+                PostgresPollingStatusType status = PQconnectPoll(conn_);
+
+                // 연결 단계에 따라 libpq가 소켓을 바꿀 수 있음
+                if (PQsocket(conn_) >= 0 &&
+                    static_cast<boost::asio::ip::tcp::socket::native_handle_type>(PQsocket(conn_)) != socket_.native_handle()) {
+                    assign_socket();
+                }
+
+                switch (status) {
+                case PGRES_POLLING_OK:
+                    on_connected();
+                    break;
+                case PGRES_POLLING_FAILED:
+                    handle_connection_error(PQerrorMessage(conn_));
+                    break;
+                case PGRES_POLLING_READING:
+                    poll_connect(true);
+                    break;
+                default:
+                    poll_connect(false);
+                    break;
+                }
+                }));
+    }
+
+    void AsyncPgClient::on_connected() {
+        if (PQsetnonblocking(conn_, 1) != 0 || PQenterPipelineMode(conn_) != 1) {
+            handle_connection_error(PQerrorMessage(conn_));
+            return;
+        }
+
+        // 카탈로그 문장 준비를 첫 파이프라인 구간으로 전송 (이후 요청은 기다리지 않고 바로 전송)
+        Unit prepare;
+        prepare.internal = true;
+        for (const auto& [name, sql] : catalog_) {
+            if (!PQsendPrepare(conn_, name.c_str(), sql.c_str(), 0, nullptr)) {
+                handle_connection_error(PQerrorMessage(conn_));
+                return;
+            }
+            prepare.statements.push_back(Statement{ name, {} });
+        }
+        if (!PQpipelineSync(conn_)) {
+            handle_connection_error(PQerrorMessage(conn_));
+            return;
+        }
+        in_flight_.push_back(std::move(prepare));
+
+        connected_ = true;
+        reconnect_delay_ = std::chrono::milliseconds(500);
+        spdlog::info("DB 비동기 연결 완료 (파이프라인 모드), 준비된 문장 {}개", catalog_.size());
+
+        start_read();
+        pump();
+        flush();
+    }
+
+    void AsyncPgClient::schedule_reconnect() {
+        if (closed_) return;
+
+        auto self = shared_from_this();
+        reconnect_timer_.expires_after(reconnect_delay_);
+        reconnect_timer_.async_wait([this, self](const boost::system::error_code& ec) {
+            if (ec || closed_) return;
+            ++reconnects_;
+            connect();
+            });
+        reconnect_delay_ = std::min(reconnect_delay_ * 2, std::chrono::milliseconds(10000));
+    }
+
+    void AsyncPgClient::handle_connection_error(const std::string& message) {
+        spdlog::error("DB 비동기 연결 오류: {}", message);
+
+        connected_ = false;
+        ++generation_;
+        reading_ = false;
+        flushing_ = false;
+        release_socket();
+        if (conn_) {
+            PQfinish(conn_);
+            conn_ = nullptr;
+        }
+
+        // 결과를 받지 못한 묶음은 순서를 유지한 채 전송 대기열 앞으로 되돌림 (시도 횟수를 넘긴 묶음은 실패로 완료)
+        std::vector<Unit> exhausted;
+        while (!in_flight_.empty()) {
+            Unit unit = std::move(in_flight_.back());
+            in_flight_.pop_back();
+            if (unit.internal) continue;
+            if (++unit.attempts >= kMaxAttempts) {
+                exhausted.push_back(std::move(unit));
+                continue;
+            }
+            unit.result = Result{};
+            unit.transient = false;
+            pending_.push_front(std::move(unit));
+            ++queued_count_;
+            ++retried_;
+        }
+        in_flight_count_ = 0;
+
+        for (auto& unit : exhausted) {
+            ++failed_;
+            unit.result.ok = false;
+            unit.result.error = "연결이 반복해서 끊겨 실행하지 못함: " + message;
+            if (unit.callback) unit.callback(std::move(unit.result));
+        }
+
+        schedule_reconnect();
+        check_drained();
+    }
+
+    void AsyncPgClient::assign_socket() {
+        release_socket();
+        boost::system::error_code ec;
+        socket_.assign(boost::asio::ip::tcp::v4(), PQsocket(conn_), ec);
+        if (ec) {
+            spdlog::error("DB 소켓 등록 실패: {}", ec.message());
+        }
+    }
+
+    void AsyncPgClient::release_socket() {
+        // 소켓은 libpq 소유이므로 닫지 않고 asio 등록만 해제
+        if (socket_.is_open()) {
+            boost::system::error_code ec;
+            socket_.release(ec);
+        }
+    }
+
+    void AsyncPgClient::pump() {
+        if (!connected_ || !conn_) return;
+
+        bool sent = false;
+        while (!pending_.empty() && in_flight_.size() < kMaxInFlight) {
+            if (!send_unit(pending_.front())) {
+                handle_connection_error(PQerrorMessage(conn_));
+                return;
+            }
+            in_flight_.push_back(std::move(pending_.front()));
+            pending_.pop_front();
+            --queued_count_;
+            ++in_flight_count_;
+            sent = true;
+        }
+
+        if (sent) {
+            ++batches_;
+            flush();
+        }
+    }
+
+    bool AsyncPgClient::send_unit(const Unit& unit) {
+        // 명시적 BEGIN/COMMIT 없이 Sync 구간 자체를 암묵적 트랜잭션으로 사용
+        // (BEGIN 뒤 문장이 실패하면 COMMIT이 건너뛰어져 연결이 트랜잭션 중단 상태로 남기 때문)
+        std::vector<const char*> values;
+        for (const auto& statement : unit.statements) {
+            values.clear();
+            for (const auto& param : statement.params) {
+                values.push_back(param.c_str());
+            }
+            if (!PQsendQueryPrepared(conn_, statement.name.c_str(), static_cast<int>(values.size()),
+                values.data(), nullptr, nullptr, 0)) {
+                return false;
+            }
+        }
+
+        // 구간 끝 표시, 구간 안에서 오류가 나면 이후 문장은 이 지점까지 건너뛰고 구간 전체를 롤백
+        return PQpipelineSync(conn_) == 1;
+    }
+
+    void AsyncPgClient::flush() {
+        if (flushing_ || !conn_) return;
+
+        int result = PQflush(conn_);
+        if (result == 0) return;
+        if (result < 0) {
+            handle_connection_error(PQerrorMessage(conn_));
+            return;
+        }
+
+        // 송신 버퍼가 가득 찬 경우 쓰기 가능해질 때 다시 전송
+        flushing_ = true;
+        auto self = shared_from_this();
+        auto generation = generation_;
+        socket_.async_wait(boost::asio::socket_base::wait_write,
+            boost::asio::bind_executor(strand_, [this, self, generation](const boost::system::error_code& ec) {
+                if (generation != generation_) return;
+                flushing_ = false;
+                if (ec) {
+                    handle_connection_error("DB 소켓 쓰기 대기 오류: " + ec.message());
+                    return;
+                }
+                flush();
+                }));
+    }
+
+    void AsyncPgClient::start_read() {
+        if (reading_ || !conn_) return;
+
+        reading_ = true;
+        auto self = shared_from_this();
+        auto generation = generation_;
+        socket_.async_wait(boost::asio::socket_base::wait_read,
+            boost::asio::bind_executor(strand_, [this, self, generation](const boost::system::error_code& ec) {
+                if (generation != generation_) return;
+                reading_ = false;
+                if (ec) {
+                    handle_connection_error("DB 소켓 읽기 대기 오류: " + ec.message());
+                    return;
+                }
+                if (!PQconsumeInput(conn_)) {
+                    handle_connection_error(PQerrorMessage(conn_));
+                    return;
+                }
+
+                process_results();
+                if (conn_ && PQstatus(conn_) == CONNECTION_BAD) {
+                    handle_connection_error(PQerrorMessage(conn_));
+                    return;
+                }
+                start_read();
+                }));
+    }
+
+    void AsyncPgClient::process_results() {
+        // 파이프라인 모드에서는 문장마다 결과 뒤에 NULL이 오고, 구간 끝에는 PIPELINE_SYNC 결과가 옴
+        int consecutive_nulls = 0;
+        while (conn_ && !in_flight_.empty() && !PQisBusy(conn_)) {
+            PGresult* res = PQgetResult(conn_);
+            if (!res) {
+                if (++consecutive_nulls > 1) break;
+                continue;
+            }
+            consecutive_nulls = 0;
+
+            Result& result = in_flight_.front().result;
+            switch (PQresultStatus(res)) {
+            case PGRES_PIPELINE_SYNC:
+                PQclear(res);
+                complete_front();
+                continue;
+            case PGRES_TUPLES_OK: {
+                Rows rows;
+                int tuples = PQntuples(res);
+                int fields = PQnfields(res);
+                rows.reserve(tuples);
+                for (int i = 0; i < tuples; ++i) {
+                    std::vector<std::string> row;
+                    row.reserve(fields);
+                    for (int j = 0; j < fields; ++j) {
+                        row.emplace_back(PQgetvalue(res, i, j), PQgetlength(res, i, j));
+                    }
+                    rows.push_back(std::move(row));
+                }
+                result.rows.push_back(std::move(rows));
+                break;
+            }
+            case PGRES_COMMAND_OK:
+                result.rows.emplace_back();
+                break;
+            case PGRES_PIPELINE_ABORTED:
+                if (result.ok) {
+                    result.ok = false;
+                    result.error = "앞선 문장 오류로 파이프라인 구간이 중단됨";
+                }
+                break;
+            default:
+                if (result.ok) {
+                    result.ok = false;
+                    result.error = PQresultErrorMessage(res);
+                    in_flight_.front().transient = isTransientError(res);
+                }
+                break;
+            }
+            PQclear(res);
+        }
+    }
+
+    void AsyncPgClient::complete_front() {
+        Unit unit = std::move(in_flight_.front());
+        in_flight_.pop_front();
+
+        if (unit.internal) {
+            if (!unit.result.ok) {
+                spdlog::error("DB 비동기 연결의 문장 준비 실패: {}", unit.result.error);
+            }
+        }
+        else if (!unit.result.ok && unit.transient && ++unit.attempts < kMaxAttempts) {
+            // 구간은 서버에서 롤백되었으므로 묶음 전체를 그대로 다시 전송
+            spdlog::warn("DB 비동기 묶음이 일시적 오류로 실패하여 다시 전송합니다 ({}/{}): {}",
+                unit.attempts, kMaxAttempts, unit.result.error);
+            --in_flight_count_;
+            ++retried_;
+            unit.result = Result{};
+            unit.transient = false;
+            pending_.push_front(std::move(unit));
+            ++queued_count_;
+        }
+        else {
+            --in_flight_count_;
+            if (unit.result.ok) {
+                ++completed_;
+            }
+            else {
+                ++failed_;
+            }
+            if (unit.callback) {
+                unit.callback(std::move(unit.result));
+            }
+        }
+
+        pump();
+        check_drained();
+    }
+
+    void AsyncPgClient::check_drained() {
+        if (drain_handlers_.empty() || queued_count_ != 0 || in_flight_count_ != 0) return;
+
+        auto handlers = std::move(drain_handlers_);
+        drain_handlers_.clear();
+        for (auto& handler : handlers) {
+            handler();
+        }
+    }
+
+    AsyncPgClient::Metrics AsyncPgClient::getMetrics() const {
+        Metrics metrics;
+        metrics.connected = connected_;
+        metrics.queued = queued_count_;
+        metrics.inFlight = in_flight_count_;
+        metrics.submitted = submitted_;
+        metrics.completed = completed_;
+        metrics.failed = failed_;
+        metrics.retried = retried_;
+        metrics.batches = batches_;
+        metrics.reconnects = reconnects_;
+        return metrics;
+    }
+
+} // namespace game_server
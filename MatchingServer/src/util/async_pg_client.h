@@ -0,0 +1,132 @@
+﻿// util/async_pg_client.h
+#pragma once
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// libpq 헤더 의존성을 줄이기 위한 전방 선언
+struct pg_conn;
+
+namespace game_server {
+
+    // libpq 비동기 API를 Boost.Asio에 연결한 PostgreSQL 클라이언트
+    // 연결 소켓의 읽기/쓰기 가능 이벤트를 asio로 기다리므로 쿼리 대기 중에도 스레드를 점유하지 않음
+    // 파이프라인 모드로 여러 요청을 응답을 기다리지 않고 연속 전송해 한 번의 왕복으로 처리
+    class AsyncPgClient : public std::enable_shared_from_this<AsyncPgClient> {
+    public:
+        // prepared statement 이름과 텍스트 형식 파라미터
+        struct Statement {
+            std::string name;
+            std::vector<std::string> params;
+        };
+
+        using Rows = std::vector<std::vector<std::string>>;
+
+        struct Result {
+            bool ok = true;
+            std::string error;
+            std::vector<Rows> rows;  // 문장별 조회 결과
+        };
+
+        using Callback = std::function<void(Result)>;
+        using Catalog = std::vector<std::pair<std::string, std::string>>;
+
+        struct Metrics {
+            bool connected;
+            std::size_t queued;
+            std::size_t inFlight;
+            std::uint64_t submitted;
+            std::uint64_t completed;
+            std::uint64_t failed;
+            std::uint64_t retried;    // 일시적 오류로 다시 전송한 묶음 수
+            std::uint64_t batches;    // 한 번에 전송한 파이프라인 묶음 수
+            std::uint64_t reconnects;
+        };
+
+        // catalog의 문장은 연결(재연결 포함)마다 파이프라인으로 준비됨
+        AsyncPgClient(boost::asio::io_context& io_context, std::string connectionString, Catalog catalog);
+        ~AsyncPgClient();
+
+        // 비동기 연결 시작, 연결이 끊기면 자동으로 재연결
+        void start();
+
+        // 문장 묶음을 하나의 파이프라인 구간으로 실행하고 결과를 콜백으로 전달 (추가한 순서대로 실행)
+        // 구간은 서버의 암묵적 트랜잭션 하나로 실행되므로 묶음 단위로 원자적으로 적용되고,
+        // 실패한 구간은 서버가 Sync 시점에 롤백하므로 다음 묶음에 영향을 주지 않음
+        // 연결이 끊겨 결과를 받지 못한 묶음은 재연결 후 다시 전송 (이미 커밋된 묶음이 다시 실행될 수 있음)
+        // 연결 끊김, 직렬화 실패, 교착 상태 같은 일시적 오류는 묶음마다 최대 kMaxAttempts번까지 시도
+        void execute(std::vector<Statement> statements, Callback callback);
+
+        // 대기 중인 묶음이 모두 끝나면 handler 호출
+        void async_drain(std::function<void()> handler);
+
+        // 연결 종료, 남은 묶음은 실패로 완료
+        void close();
+
+        Metrics getMetrics() const;
+
+    private:
+        struct Unit {
+            std::vector<Statement> statements;
+            bool internal = false;  // 연결 직후 문장 준비용
+            int attempts = 0;       // 결과를 받지 못했거나 일시적 오류로 끝난 전송 횟수
+            bool transient = false; // 이번 전송의 실패가 다시 시도할 수 있는 오류인지 여부
+            Callback callback;
+            Result result;
+        };
+
+        void connect();
+        void poll_connect(bool wait_for_read);
+        void on_connected();
+        void schedule_reconnect();
+        void handle_connection_error(const std::string& message);
+        void assign_socket();
+        void release_socket();
+
+        void pump();
+        bool send_unit(const Unit& unit);
+        void flush();
+        void start_read();
+        void process_results();
+        void complete_front();
+        void check_drained();
+
+        static constexpr std::size_t kMaxInFlight = 128;
+        static constexpr int kMaxAttempts = 5;
+
+        boost::asio::strand<boost::asio::io_context::executor_type> strand_;
+        boost::asio::ip::tcp::socket socket_;
+        boost::asio::steady_timer reconnect_timer_;
+        std::chrono::milliseconds reconnect_delay_{ 500 };
+
+        const std::string connection_string_;
+        const Catalog catalog_;
+        pg_conn* conn_ = nullptr;
+        bool closed_ = false;
+        bool reading_ = false;
+        bool flushing_ = false;
+        std::uint64_t generation_ = 0;  // 연결마다 증가, 이전 연결의 핸들러 무시용
+
+        std::deque<Unit> pending_;    // 아직 전송하지 않은 묶음
+        std::deque<Unit> in_flight_;  // 전송 후 결과를 기다리는 묶음
+        std::vector<std::function<void()>> drain_handlers_;
+
+        std::atomic<bool> connected_{ false };
+        std::atomic<std::size_t> queued_count_{ 0 };
+        std::atomic<std::size_t> in_flight_count_{ 0 };
+        std::atomic<std::uint64_t> submitted_{ 0 };
+        std::atomic<std::uint64_t> completed_{ 0 };
+        std::atomic<std::uint64_t> failed_{ 0 };
+        std::atomic<std::uint64_t> retried_{ 0 };
+        std::atomic<std::uint64_t> batches_{ 0 };
+        std::atomic<std::uint64_t> reconnects_{ 0 };
+    };
+
+} // namespace game_server
@@ -1,10 +1,12 @@
 ﻿#include "db_pool.h"
+#include "query_stats.h"
 
 // 표준 라이브러리 헤더 포함
 #include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <stdexcept>
 
 // 로깅 라이브러리
@@ -15,19 +17,57 @@
 
 namespace game_server {
 
-    DbPool::DbPool(const std::string& connectionString, int poolSize)
-        : connection_string_(connectionString)
+    DbPool::Lease::Lease(Lease&& other) noexcept
+        : pool_(other.pool_), index_(other.index_)
+    {
+        other.pool_ = nullptr;
+    }
+
+    DbPool::Lease& DbPool::Lease::operator=(Lease&& other) noexcept {
+        if (this != &other) {
+            release();
+            pool_ = other.pool_;
+            index_ = other.index_;
+            other.pool_ = nullptr;
+        }
+        return *this;
+    }
+
+    DbPool::Lease::~Lease() {
+        release();
+    }
+
+    pqxx::connection& DbPool::Lease::operator*() const {
+        return *pool_->connections_[index_];
+    }
+
+    pqxx::connection* DbPool::Lease::operator->() const {
+        return pool_->connections_[index_].get();
+    }
+
+    void DbPool::Lease::release() {
+        if (pool_) {
+            DbPool* pool = pool_;
+            pool_ = nullptr;
+            pool->release(index_);
+        }
+    }
+
+    DbPool::DbPool(const std::string& connectionString, int poolSize, std::chrono::milliseconds acquireTimeout,
+        ConnectionInitializer initializer)
+        : connection_string_(connectionString),
+        initializer_(std::move(initializer)),
+        acquire_timeout_(acquireTimeout)
     {
         try {
-            // 연결 풀 초기화
+            // 연결 풀 초기화 (풀 크기가 곧 최대 연결 수)
             connections_.reserve(poolSize);
-            in_use_.reserve(poolSize);
+            free_.reserve(poolSize);
 
             for (int i = 0; i < poolSize; ++i) {
                 // 새 연결 생성 및 풀에 추가
-                auto conn = std::make_shared<pqxx::connection>(connectionString);
-                connections_.push_back(conn);
-                in_use_.push_back(false);
+                connections_.push_back(open_connection());
+                free_.push_back(i);
 
                 spdlog::info("데이터베이스 연결 생성 {}/{}", i + 1, poolSize);
             }
@@ -43,63 +83,145 @@ namespace game_server {
     DbPool::~DbPool()
     {
         // 모든 연결 종료
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            waiters_.clear();
+        }
         connections_.clear();
         spdlog::info("데이터베이스 풀 삭제");
     }
 
-    std::shared_ptr<pqxx::connection> DbPool::get_connection()
+    void DbPool::setReplica(std::unique_ptr<DbPool> replica, bool fallbackToPrimary)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        replica_ = std::move(replica);
+        fallback_to_primary_ = fallbackToPrimary;
+    }
 
-        // 사용 가능한 연결 찾기
-        for (size_t i = 0; i < connections_.size(); ++i) {
-            if (!in_use_[i]) {
-                in_use_[i] = true;
-
-                // 연결이 유효한지 확인
-                if (!connections_[i]->is_open()) {
-                    spdlog::warn("{}번째 연결이 종료되었습니다, 재연결 진행 중...", i);
-                    try {
-                        connections_[i] = std::make_shared<pqxx::connection>(connection_string_);
-                    }
-                    catch (const std::exception& e) {
-                        spdlog::error("재연결 중 예외가 발생하였습니다: {}", e.what());
-                        in_use_[i] = false;
-                        throw;
-                    }
-                }
+    DbPool::Lease DbPool::acquire(Access access)
+    {
+        // 읽기 전용 조회는 복제본 풀에서 먼저 시도
+        if (access == Access::Read && replica_) {
+            try {
+                Lease lease = replica_->acquire();
+                ++replica_reads_;
+                return lease;
+            }
+            catch (const std::exception& e) {
+                if (!fallback_to_primary_) throw;
+                ++replica_fallbacks_;
+                spdlog::warn("읽기 전용 DB 연결을 얻지 못해 기본 DB에서 조회합니다: {}", e.what());
+            }
+        }
 
-                return connections_[i];
+        auto start = std::chrono::steady_clock::now();
+        std::size_t index;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+
+            // 대기자가 없고 빈 연결이 있으면 바로 사용
+            if (waiters_.empty() && !free_.empty()) {
+                index = free_.back();
+                free_.pop_back();
+            }
+            else {
+                // 모든 연결이 사용 중이면 순서대로 대기 (연결을 추가로 만들지 않음)
+                auto waiter = std::make_shared<Waiter>();
+                waiter->since = std::chrono::steady_clock::now();
+                waiters_.push_back(waiter);
+                max_waiting_ = std::max(max_waiting_, waiters_.size());
+
+                if (!waiter->cv.wait_for(lock, acquire_timeout_, [&waiter]() { return waiter->granted; })) {
+                    waiters_.erase(std::find(waiters_.begin(), waiters_.end(), waiter));
+                    ++timeouts_;
+                    spdlog::warn("데이터베이스 연결 대기 시간 초과 ({}ms), 대기 중인 요청 수 : {}",
+                        acquire_timeout_.count(), waiters_.size());
+                    throw std::runtime_error("데이터베이스 연결 대기 시간 초과");
+                }
+                index = waiter->index;
             }
         }
 
-        // 사용 가능한 연결이 없으면 새 연결 생성
-        spdlog::warn("사용 가능한 연결이 없습니다, 연결을 추가로 생성합니다");
+        QueryStats::recordPoolWait(std::chrono::steady_clock::now() - start);
+        ++acquired_;
+        if (!ensure_open(index)) {
+            release(index);
+            throw std::runtime_error("데이터베이스 재연결 실패");
+        }
+        return Lease(this, index);
+    }
+
+    std::unique_ptr<pqxx::connection> DbPool::open_connection()
+    {
+        auto conn = std::make_unique<pqxx::connection>(connection_string_);
+        if (initializer_) {
+            initializer_(*conn);
+        }
+        return conn;
+    }
+
+    bool DbPool::ensure_open(std::size_t index)
+    {
+        // 대여된 연결은 대여자만 접근하므로 잠금 없이 교체 가능
+        if (connections_[index]->is_open()) {
+            return true;
+        }
+
+        spdlog::warn("{}번째 연결이 종료되었습니다, 재연결 진행 중...", index);
         try {
-            auto conn = std::make_shared<pqxx::connection>(connection_string_);
-            connections_.push_back(conn);
-            in_use_.push_back(true);
-            return conn;
+            connections_[index] = open_connection();
+            ++reconnects_;
+            return true;
         }
         catch (const std::exception& e) {
-            spdlog::error("연결 추가 중 예외가 발생하였습니다: {}", e.what());
-            throw;
+            spdlog::error("재연결 중 예외가 발생하였습니다: {}", e.what());
+            return false;
         }
     }
 
-    void DbPool::return_connection(std::shared_ptr<pqxx::connection> conn)
+    void DbPool::release(std::size_t index)
     {
         std::lock_guard<std::mutex> lock(mutex_);
-
-        // 반환된 연결 찾아서 사용 가능 상태로 변경
-        for (size_t i = 0; i < connections_.size(); ++i) {
-            if (connections_[i] == conn) {
-                in_use_[i] = false;
-                return;
-            }
+        if (waiters_.empty()) {
+            free_.push_back(index);
+            return;
         }
 
-        spdlog::warn("데이터베이스 풀로 반환 가능한 연결을 찾지 못했습니다");
+        // 가장 오래 기다린 요청에게 연결을 바로 넘김
+        auto waiter = std::move(waiters_.front());
+        waiters_.pop_front();
+        record_wait(waiter->since);
+        waiter->index = index;
+        waiter->granted = true;
+        waiter->cv.notify_one();
+    }
+
+    void DbPool::record_wait(std::chrono::steady_clock::time_point since)
+    {
+        auto waited = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - since).count();
+        ++waited_;
+        total_wait_us_ += waited;
+        max_wait_us_ = std::max<std::uint64_t>(max_wait_us_, waited);
+    }
+
+    DbPool::Metrics DbPool::getMetrics() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Metrics metrics;
+        metrics.size = connections_.size();
+        metrics.inUse = connections_.size() - free_.size();
+        metrics.waiting = waiters_.size();
+        metrics.maxWaiting = max_waiting_;
+        metrics.utilization = metrics.size ? static_cast<double>(metrics.inUse) / metrics.size : 0.0;
+        metrics.acquired = acquired_;
+        metrics.waited = waited_;
+        metrics.timeouts = timeouts_;
+        metrics.reconnects = reconnects_;
+        metrics.avgWaitMs = waited_ ? total_wait_us_ / 1000.0 / waited_ : 0.0;
+        metrics.maxWaitMs = max_wait_us_ / 1000.0;
+        metrics.replicaReads = replica_reads_;
+        metrics.replicaFallbacks = replica_fallbacks_;
+        return metrics;
     }
 
-} // namespace game_server
\ No newline at end of file
+} // namespace game_server
@@ -2,8 +2,14 @@
 
 #include <string>
 #include <vector>
+#include <deque>
 #include <mutex>
 #include <memory>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <condition_variable>
 
 // Forward declaration to reduce header dependencies
 namespace pqxx {
@@ -12,22 +18,110 @@ namespace pqxx {
 
 namespace game_server {
 
+    // Fixed-size connection pool
+    // Free connections are kept in a free list, callers wait in FIFO order when every connection is busy
     class DbPool {
     public:
-        DbPool(const std::string& connectionString, int poolSize);
+        // Query intent, reads may be served by the replica pool and may see slightly stale data
+        enum class Access { Write, Read };
+
+        // RAII handle to a pooled connection, returns it to the pool on destruction
+        class Lease {
+        public:
+            Lease() = default;
+            Lease(Lease&& other) noexcept;
+            Lease& operator=(Lease&& other) noexcept;
+            Lease(const Lease&) = delete;
+            Lease& operator=(const Lease&) = delete;
+            ~Lease();
+
+            pqxx::connection& operator*() const;
+            pqxx::connection* operator->() const;
+            explicit operator bool() const { return pool_ != nullptr; }
+
+            // Return the connection early
+            void release();
+
+        private:
+            friend class DbPool;
+            Lease(DbPool* pool, std::size_t index) : pool_(pool), index_(index) {}
+
+            DbPool* pool_ = nullptr;
+            std::size_t index_ = 0;
+        };
+
+        struct Metrics {
+            std::size_t size;
+            std::size_t inUse;
+            std::size_t waiting;
+            std::size_t maxWaiting;
+            double utilization;
+            std::uint64_t acquired;
+            std::uint64_t waited;
+            std::uint64_t timeouts;
+            std::uint64_t reconnects;
+            double avgWaitMs;
+            double maxWaitMs;
+            std::uint64_t replicaReads;      // reads served by the replica pool
+            std::uint64_t replicaFallbacks;  // reads served here because the replica was unavailable
+        };
+
+        // Runs on every new connection, including reconnects (e.g. to prepare statements)
+        using ConnectionInitializer = std::function<void(pqxx::connection&)>;
+
+        DbPool(const std::string& connectionString, int poolSize,
+            std::chrono::milliseconds acquireTimeout = std::chrono::seconds(3),
+            ConnectionInitializer initializer = nullptr);
         ~DbPool();
 
-        // Get a connection from pool
-        std::shared_ptr<pqxx::connection> get_connection();
+        // Send Access::Read acquires to a replica pool
+        // With fallbackToPrimary, a read that cannot get a replica connection is served by this pool instead of failing
+        void setReplica(std::unique_ptr<DbPool> replica, bool fallbackToPrimary);
+        const DbPool* replica() const { return replica_.get(); }
+
+        // Block until a connection is free, throws std::runtime_error after the acquire timeout
+        // Callers are worker pool threads that go on to run a blocking pqxx query with the lease,
+        // so waiting here in FIFO order is the wait queue; IO threads never acquire.
+        // Non-blocking DB access goes through AsyncPgClient instead of this pool.
+        Lease acquire(Access access = Access::Write);
 
-        // Return a connection to pool
-        void return_connection(std::shared_ptr<pqxx::connection> conn);
+        Metrics getMetrics() const;
 
     private:
+        struct Waiter {
+            std::condition_variable cv;
+            bool granted = false;
+            std::size_t index = 0;
+            std::chrono::steady_clock::time_point since;
+        };
+
+        std::unique_ptr<pqxx::connection> open_connection();
+
+        // Reopen a closed connection before handing it out, returns false on failure
+        bool ensure_open(std::size_t index);
+        void release(std::size_t index);
+        void record_wait(std::chrono::steady_clock::time_point since);
+
         std::string connection_string_;
-        std::vector<std::shared_ptr<pqxx::connection>> connections_;
-        std::vector<bool> in_use_;
-        std::mutex mutex_;
+        ConnectionInitializer initializer_;
+        std::vector<std::unique_ptr<pqxx::connection>> connections_;
+        std::vector<std::size_t> free_;
+        std::deque<std::shared_ptr<Waiter>> waiters_;
+        const std::chrono::milliseconds acquire_timeout_;
+        mutable std::mutex mutex_;
+
+        std::size_t max_waiting_ = 0;
+        std::uint64_t total_wait_us_ = 0;
+        std::uint64_t max_wait_us_ = 0;
+        std::atomic<std::uint64_t> acquired_{ 0 };
+        std::uint64_t waited_ = 0;
+        std::atomic<std::uint64_t> timeouts_{ 0 };
+        std::atomic<std::uint64_t> reconnects_{ 0 };
+
+        std::unique_ptr<DbPool> replica_;
+        bool fallback_to_primary_ = true;
+        std::atomic<std::uint64_t> replica_reads_{ 0 };
+        std::atomic<std::uint64_t> replica_fallbacks_{ 0 };
     };
 
 } // namespace game_server
@@ -0,0 +1,119 @@
+﻿// util/input_validator.cpp
+// 입력 형식 검증 구현 파일
+// ASCII는 문자 종류 표로, 그 외는 UTF-8을 디코딩해 한글 음절 범위(U+AC00~U+D7A3)로 확인
+#include "input_validator.h"
+#include <array>
+#include <cstdint>
+
+namespace game_server {
+
+    namespace {
+
+        enum CharClass : std::uint8_t {
+            kAlnum = 1 << 0,        // A-Z a-z 0-9
+            kSpace = 1 << 1,        // ' '
+            kEmailSymbol = 1 << 2   // @ . _ - +
+        };
+
+        constexpr std::array<std::uint8_t, 128> makeAsciiTable() {
+            std::array<std::uint8_t, 128> table{};
+            for (int c = 'A'; c <= 'Z'; ++c) table[c] |= kAlnum;
+            for (int c = 'a'; c <= 'z'; ++c) table[c] |= kAlnum;
+            for (int c = '0'; c <= '9'; ++c) table[c] |= kAlnum;
+            table[' '] |= kSpace;
+            for (char c : { '@', '.', '_', '-', '+' }) table[static_cast<unsigned char>(c)] |= kEmailSymbol;
+            return table;
+        }
+
+        constexpr auto kAsciiTable = makeAsciiTable();
+
+        constexpr char32_t kInvalid = 0xFFFFFFFF;
+
+        // pos 위치의 UTF-8 문자 하나를 디코딩하고 pos를 다음 문자로 이동
+        // 잘린 문자, 과잉 표현(overlong), 서로게이트, 범위 밖 값은 kInvalid
+        char32_t decodeUtf8(std::string_view s, std::size_t& pos) {
+            auto byte = [&](std::size_t i) { return static_cast<unsigned char>(s[i]); };
+            unsigned char lead = byte(pos);
+
+            if (lead < 0x80) {
+                ++pos;
+                return lead;
+            }
+
+            std::size_t length;
+            char32_t cp;
+            char32_t min;
+            if ((lead & 0xE0) == 0xC0) { length = 2; cp = lead & 0x1F; min = 0x80; }
+            else if ((lead & 0xF0) == 0xE0) { length = 3; cp = lead & 0x0F; min = 0x800; }
+            else if ((lead & 0xF8) == 0xF0) { length = 4; cp = lead & 0x07; min = 0x10000; }
+            else return kInvalid;
+
+            if (pos + length > s.size()) return kInvalid;
+            for (std::size_t i = 1; i < length; ++i) {
+                unsigned char next = byte(pos + i);
+                if ((next & 0xC0) != 0x80) return kInvalid;
+                cp = (cp << 6) | (next & 0x3F);
+            }
+            if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return kInvalid;
+
+            pos += length;
+            return cp;
+        }
+
+        bool isHangulSyllable(char32_t cp) {
+            return cp >= 0xAC00 && cp <= 0xD7A3;
+        }
+
+        // 모든 문자가 ASCII 종류(allowed) 또는 한글 음절(allowHangul)인지 확인
+        bool matches(std::string_view s, std::uint8_t allowed, bool allowHangul) {
+            std::size_t pos = 0;
+            while (pos < s.size()) {
+                char32_t cp = decodeUtf8(s, pos);
+                if (cp < 0x80) {
+                    if (!(kAsciiTable[cp] & allowed)) return false;
+                }
+                else if (!allowHangul || !isHangulSyllable(cp)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    } // namespace
+
+    bool InputValidator::isValidUserName(std::string_view name) {
+        if (name.empty() || name.size() > kMaxUserNameBytes) {
+            return false;
+        }
+
+        // "mirror" 단어가 포함된 이름은 미러 서버 세션과 혼동되므로 허용하지 않음
+        if (name.find("mirror") != std::string_view::npos) {
+            return false;
+        }
+
+        // 이메일 형식이면 이메일 문자 허용, 아니면 영문/숫자만 허용 (한글 불가)
+        auto at = name.find('@');
+        bool isEmail = at != std::string_view::npos && name.find('.', at) != std::string_view::npos;
+        return matches(name, isEmail ? (kAlnum | kEmailSymbol) : kAlnum, false);
+    }
+
+    bool InputValidator::isValidNickName(std::string_view name) {
+        if (name.empty() || name.size() > kMaxNickNameBytes) {
+            return false;
+        }
+        return matches(name, kAlnum, true);
+    }
+
+    bool InputValidator::isValidRoomName(std::string_view name) {
+        if (name.empty() || name.size() > kMaxRoomNameBytes) {
+            return false;
+        }
+
+        // 마지막 '$'는 허용 (이름 본문만 검사)
+        if (name.back() == '$') {
+            name.remove_suffix(1);
+        }
+        return matches(name, kAlnum | kSpace, true);
+    }
+
+} // namespace game_server
@@ -0,0 +1,26 @@
+﻿// util/input_validator.h
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+namespace game_server {
+
+    // 사용자 이름, 닉네임, 방 이름 형식 검증
+    // UTF-8을 한 번 훑으면서 문자 종류를 표로 확인하며 힙 할당을 하지 않음
+    class InputValidator {
+    public:
+        static constexpr std::size_t kMaxUserNameBytes = 30;
+        static constexpr std::size_t kMaxNickNameBytes = 24;
+        static constexpr std::size_t kMaxRoomNameBytes = 40;
+
+        // 영문/숫자, 또는 이메일 형식(영문/숫자와 @ . _ - +), "mirror" 포함 불가
+        static bool isValidUserName(std::string_view name);
+
+        // 한글 음절(가-힣), 영문, 숫자
+        static bool isValidNickName(std::string_view name);
+
+        // 한글 음절, 영문, 숫자, 공백 (마지막 글자로 '$' 허용)
+        static bool isValidRoomName(std::string_view name);
+    };
+
+} // namespace game_server
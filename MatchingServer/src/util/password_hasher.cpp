@@ -0,0 +1,32 @@
+﻿// util/password_hasher.cpp
+// 비밀번호 해싱 전용 스레드 풀 구현 파일
+#include "password_hasher.h"
+#include "password_util.h"
+
+namespace game_server {
+
+    PasswordHasher::PasswordHasher(int threadCount, std::size_t queueLimit)
+        : pool_(threadCount, queueLimit, "비밀번호 해싱 풀") {
+    }
+
+    std::future<std::string> PasswordHasher::hashAsync(std::string password) {
+        return submit([password = std::move(password)]() {
+            return PasswordUtil::hashPassword(password);
+            });
+    }
+
+    std::future<bool> PasswordHasher::verifyAsync(std::string password, std::string hashedPassword) {
+        return submit([password = std::move(password), hashedPassword = std::move(hashedPassword)]() {
+            return PasswordUtil::verifyPassword(password, hashedPassword);
+            });
+    }
+
+    void PasswordHasher::stop() {
+        pool_.stop();
+    }
+
+    PasswordHasher::Metrics PasswordHasher::getMetrics() const {
+        return pool_.getMetrics();
+    }
+
+} // namespace game_server
@@ -0,0 +1,49 @@
+﻿// util/password_hasher.h
+#pragma once
+#include "worker_pool.h"
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace game_server {
+
+    // 대기열이 가득 차 해싱 작업을 받지 못한 경우
+    class PasswordHasherBusy : public std::runtime_error {
+    public:
+        PasswordHasherBusy() : std::runtime_error("비밀번호 해싱 대기열이 가득 찼습니다") {}
+    };
+
+    // 비밀번호 해싱/검증 전용 스레드 풀
+    // 해싱 비용이 커져도 정해진 스레드 수만큼만 CPU를 쓰므로 로비 요청 처리를 굶기지 않음
+    class PasswordHasher {
+    public:
+        using Metrics = WorkerPool::Metrics;
+
+        PasswordHasher(int threadCount, std::size_t queueLimit);
+
+        // 결과는 해싱 스레드에서 채워짐, 대기열이 가득 차면 future가 PasswordHasherBusy를 던짐
+        std::future<std::string> hashAsync(std::string password);
+        std::future<bool> verifyAsync(std::string password, std::string hashedPassword);
+
+        void stop();
+        Metrics getMetrics() const;
+
+    private:
+        template <typename F>
+        auto submit(F task) -> std::future<decltype(task())> {
+            using Result = decltype(task());
+            auto packaged = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+            auto future = packaged->get_future();
+            if (!pool_.submit([packaged]() { (*packaged)(); })) {
+                std::promise<Result> rejected;
+                rejected.set_exception(std::make_exception_ptr(PasswordHasherBusy()));
+                return rejected.get_future();
+            }
+            return future;
+        }
+
+        WorkerPool pool_;
+    };
+
+} // namespace game_server
@@ -2,33 +2,47 @@
 // 비밀번호 유틸리티 구현 파일
 // 비밀번호 해싱 및 검증 기능 제공
 #include "password_util.h"
+#include <openssl/crypto.h>
 #include <openssl/sha.h>
-#include <iomanip>
-#include <sstream>
 #include <spdlog/spdlog.h>
 
 namespace game_server {
 
-    std::string PasswordUtil::hashPassword(const std::string& password) {
-        // 보안 참고: 실제 제품에서는 더 안전한 해싱 알고리즘 사용 필요
-        unsigned char hash[SHA256_DIGEST_LENGTH];
-        SHA256(reinterpret_cast<const unsigned char*>(password.c_str()),
-            password.length(), hash);
-
-        // 해시를 16진수 문자열로 변환
-        std::stringstream ss;
-        for (int i = 0; i < SHA256_DIGEST_LENGTH; i++) {
-            ss << std::hex << std::setw(2) << std::setfill('0')
-                << static_cast<int>(hash[i]);
+    namespace {
+        // SHA-256 해시를 16진수로 변환해 out에 기록 (힙 할당 없음)
+        void hashToHex(const std::string& password, char* out) {
+            // 보안 참고: 실제 제품에서는 더 안전한 해싱 알고리즘 사용 필요
+            unsigned char hash[SHA256_DIGEST_LENGTH];
+            SHA256(reinterpret_cast<const unsigned char*>(password.data()),
+                password.size(), hash);
+            PasswordUtil::toHex(hash, SHA256_DIGEST_LENGTH, out);
         }
+    }
 
-        return ss.str();
+    std::string PasswordUtil::hashPassword(const std::string& password) {
+        std::string hex(kHashLength, '\0');
+        hashToHex(password, hex.data());
+        return hex;
     }
 
     bool PasswordUtil::verifyPassword(const std::string& password, const std::string& hashedPassword) {
-        // 입력된 비밀번호의 해시와 저장된 해시 비교
-        std::string computedHash = hashPassword(password);
-        return computedHash == hashedPassword;
+        // 입력된 비밀번호의 해시와 저장된 해시 비교 (비교 시간으로 일치 길이를 알 수 없도록 고정 시간 비교)
+        char computed[kHashLength];
+        hashToHex(password, computed);
+        return constantTimeEquals(std::string_view(computed, kHashLength), hashedPassword);
+    }
+
+    void PasswordUtil::toHex(const unsigned char* data, std::size_t size, char* out) {
+        static constexpr char kDigits[] = "0123456789abcdef";
+        for (std::size_t i = 0; i < size; ++i) {
+            out[i * 2] = kDigits[data[i] >> 4];
+            out[i * 2 + 1] = kDigits[data[i] & 0x0F];
+        }
+    }
+
+    bool PasswordUtil::constantTimeEquals(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) return false;
+        return CRYPTO_memcmp(a.data(), b.data(), a.size()) == 0;
     }
 
-} // namespace game_server
\ No newline at end of file
+} // namespace game_server
@@ -1,14 +1,25 @@
 ﻿// util/password_util.h
 #pragma once
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 namespace game_server {
 
     class PasswordUtil {
     public:
+        // SHA-256 16진수 문자열 길이
+        static constexpr std::size_t kHashLength = 64;
+
         static std::string hashPassword(const std::string& password);
 
         static bool verifyPassword(const std::string& password, const std::string& hashedPassword);
+
+        // 바이트 배열을 소문자 16진수로 변환해 out에 기록 (out은 size * 2 바이트 이상)
+        static void toHex(const unsigned char* data, std::size_t size, char* out);
+
+        // 내용과 무관하게 같은 시간이 걸리는 비교 (길이가 다르면 바로 false)
+        static bool constantTimeEquals(std::string_view a, std::string_view b);
     };
 
 } // namespace game_server
@@ -0,0 +1,185 @@
+﻿// util/query_stats.cpp
+// 쿼리 계측 구현 파일
+// 기록은 원자적 카운터로 처리하고 문장/액션 항목을 처음 만들 때만 배타 잠금 사용
+#include "query_stats.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    using json = nlohmann::json;
+
+    namespace {
+
+        struct StatementStats {
+            LatencyHistogram latency;
+            std::atomic<std::uint64_t> rows{ 0 };
+            std::atomic<std::uint64_t> errors{ 0 };
+        };
+
+        struct ActionStats {
+            std::atomic<std::uint64_t> requests{ 0 };
+            std::atomic<std::uint64_t> queries{ 0 };
+            std::atomic<std::uint64_t> maxQueries{ 0 };
+            std::atomic<std::uint64_t> manyQueries{ 0 };    // kManyQueriesPerRequest 초과 요청 수
+        };
+
+        // 이름별 항목 (한 번 만든 항목은 지우지 않으므로 포인터를 잠금 밖에서 사용 가능)
+        template <typename T>
+        class Registry {
+        public:
+            T& get(const std::string& name) {
+                {
+                    std::shared_lock<std::shared_mutex> lock(mutex_);
+                    auto it = entries_.find(name);
+                    if (it != entries_.end()) return *it->second;
+                }
+                std::unique_lock<std::shared_mutex> lock(mutex_);
+                auto& entry = entries_[name];
+                if (!entry) entry = std::make_unique<T>();
+                return *entry;
+            }
+
+            template <typename F>
+            void forEach(F&& visit) const {
+                std::shared_lock<std::shared_mutex> lock(mutex_);
+                for (const auto& [name, entry] : entries_) visit(name, *entry);
+            }
+
+        private:
+            mutable std::shared_mutex mutex_;
+            std::unordered_map<std::string, std::unique_ptr<T>> entries_;
+        };
+
+        Registry<StatementStats>& statements() {
+            static Registry<StatementStats> registry;
+            return registry;
+        }
+
+        Registry<ActionStats>& actions() {
+            static Registry<ActionStats> registry;
+            return registry;
+        }
+
+        LatencyHistogram& poolWait() {
+            static LatencyHistogram histogram;
+            return histogram;
+        }
+
+        thread_local QueryStats::RequestScope* current_request = nullptr;
+
+        void updateMax(std::atomic<std::uint64_t>& target, std::uint64_t value) {
+            std::uint64_t current = target.load(std::memory_order_relaxed);
+            while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        }
+
+    } // namespace
+
+    void LatencyHistogram::record(std::chrono::steady_clock::duration elapsed) {
+        auto us = static_cast<std::uint64_t>(std::max<std::int64_t>(0,
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+        auto bucket = std::upper_bound(kBoundsUs.begin(), kBoundsUs.end(), us) - kBoundsUs.begin();
+        buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        total_us_.fetch_add(us, std::memory_order_relaxed);
+        updateMax(max_us_, us);
+    }
+
+    json LatencyHistogram::toJson() const {
+        std::array<std::uint64_t, kBoundsUs.size() + 1> counts;
+        std::uint64_t count = 0;
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            counts[i] = buckets_[i].load(std::memory_order_relaxed);
+            count += counts[i];
+        }
+
+        // 누적 횟수가 비율을 넘는 첫 구간의 상한 (최대값을 넘지 않게 제한)
+        std::uint64_t max_us = max_us_.load();
+        auto percentile = [&](double ratio) {
+            if (count == 0) return 0.0;
+            auto target = static_cast<std::uint64_t>(count * ratio);
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < kBoundsUs.size(); ++i) {
+                seen += counts[i];
+                if (seen > target) return std::min(kBoundsUs[i], max_us) / 1000.0;
+            }
+            return max_us / 1000.0;
+        };
+
+        return {
+            {"count", count},
+            {"avgMs", count ? total_us_.load() / 1000.0 / count : 0.0},
+            {"maxMs", max_us / 1000.0},
+            {"p50Ms", percentile(0.50)},
+            {"p95Ms", percentile(0.95)},
+            {"p99Ms", percentile(0.99)},
+            {"buckets", counts}
+        };
+    }
+
+    QueryStats::RequestScope::RequestScope(std::string action)
+        : action_(std::move(action)), previous_(current_request) {
+        current_request = this;
+    }
+
+    QueryStats::RequestScope::~RequestScope() {
+        current_request = previous_;
+
+        auto& stats = actions().get(action_);
+        stats.requests.fetch_add(1, std::memory_order_relaxed);
+        stats.queries.fetch_add(queries_, std::memory_order_relaxed);
+        updateMax(stats.maxQueries, queries_);
+        if (queries_ > kManyQueriesPerRequest) {
+            stats.manyQueries.fetch_add(1, std::memory_order_relaxed);
+            spdlog::warn("요청 하나에서 쿼리 {}회 실행 (N+1 의심), 액션: {}", queries_, action_);
+        }
+    }
+
+    void QueryStats::recordQuery(const char* name, std::chrono::steady_clock::duration elapsed, std::size_t rows, bool ok) {
+        auto& stats = statements().get(name);
+        stats.latency.record(elapsed);
+        stats.rows.fetch_add(rows, std::memory_order_relaxed);
+        if (!ok) stats.errors.fetch_add(1, std::memory_order_relaxed);
+
+        if (current_request) {
+            ++current_request->queries_;
+        }
+    }
+
+    void QueryStats::recordPoolWait(std::chrono::steady_clock::duration waited) {
+        poolWait().record(waited);
+    }
+
+    json QueryStats::snapshot() {
+        json statementsJson = json::object();
+        statements().forEach([&](const std::string& name, const StatementStats& stats) {
+            json entry = stats.latency.toJson();
+            entry["rows"] = stats.rows.load();
+            entry["errors"] = stats.errors.load();
+            statementsJson[name] = std::move(entry);
+            });
+
+        json actionsJson = json::object();
+        actions().forEach([&](const std::string& name, const ActionStats& stats) {
+            auto requests = stats.requests.load();
+            actionsJson[name] = {
+                {"requests", requests},
+                {"queriesPerRequest", requests ? static_cast<double>(stats.queries.load()) / requests : 0.0},
+                {"maxQueriesPerRequest", stats.maxQueries.load()},
+                {"manyQueryRequests", stats.manyQueries.load()}
+            };
+            });
+
+        return {
+            {"bucketBoundsUs", LatencyHistogram::kBoundsUs},
+            {"poolWait", poolWait().toJson()},
+            {"statements", std::move(statementsJson)},
+            {"requests", std::move(actionsJson)}
+        };
+    }
+
+} // namespace game_server
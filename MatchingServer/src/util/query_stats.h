@@ -0,0 +1,74 @@
+﻿// util/query_stats.h
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+
+    // 지연 시간 히스토그램 (마이크로초 단위 고정 구간)
+    class LatencyHistogram {
+    public:
+        static constexpr std::array<std::uint64_t, 13> kBoundsUs = {
+            100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000
+        };
+
+        void record(std::chrono::steady_clock::duration elapsed);
+
+        // 횟수, 평균/최대, 구간 상한으로 추정한 p50/p95/p99 (밀리초), 구간별 횟수
+        nlohmann::json toJson() const;
+
+    private:
+        std::array<std::atomic<std::uint64_t>, kBoundsUs.size() + 1> buckets_{};
+        std::atomic<std::uint64_t> count_{ 0 };
+        std::atomic<std::uint64_t> total_us_{ 0 };
+        std::atomic<std::uint64_t> max_us_{ 0 };
+    };
+
+    // 리포지토리 쿼리 계측
+    // 문장별 지연 시간/반환 행 수/오류 수, DB 풀 대기 시간, 요청 액션별 쿼리 수를 프로세스 단위로 집계
+    class QueryStats {
+    public:
+        // 워커 스레드에서 클라이언트 요청 하나를 처리하는 동안 실행된 쿼리 수를 세는 범위
+        class RequestScope {
+        public:
+            explicit RequestScope(std::string action);
+            ~RequestScope();
+            RequestScope(const RequestScope&) = delete;
+            RequestScope& operator=(const RequestScope&) = delete;
+
+        private:
+            friend class QueryStats;
+            std::string action_;
+            RequestScope* previous_;
+            std::uint32_t queries_ = 0;
+        };
+
+        // 요청 하나에서 이 수를 넘게 쿼리하면 N+1 의심으로 경고 로그 출력
+        static constexpr std::uint32_t kManyQueriesPerRequest = 8;
+
+        static void recordQuery(const char* name, std::chrono::steady_clock::duration elapsed, std::size_t rows, bool ok);
+        static void recordPoolWait(std::chrono::steady_clock::duration waited);
+        static nlohmann::json snapshot();
+
+        // prepared statement 실행 후 소요 시간, 반환 행 수, 오류 여부 기록
+        template <typename Txn, typename... Args>
+        static auto execPrepared(Txn& txn, const char* name, Args&&... args) {
+            auto start = std::chrono::steady_clock::now();
+            try {
+                auto result = txn.exec_prepared(name, std::forward<Args>(args)...);
+                recordQuery(name, std::chrono::steady_clock::now() - start, result.size(), true);
+                return result;
+            }
+            catch (...) {
+                recordQuery(name, std::chrono::steady_clock::now() - start, 0, false);
+                throw;
+            }
+        }
+    };
+
+} // namespace game_server
@@ -0,0 +1,18 @@
+﻿// util/time_util.cpp
+// 시각 관련 유틸리티 구현 파일
+#include "time_util.h"
+#include <chrono>
+#include <ctime>
+#include <spdlog/spdlog.h>
+#include <spdlog/fmt/chrono.h>
+
+namespace game_server {
+
+    std::string TimeUtil::currentTimestamp() {
+        auto now = std::chrono::system_clock::now();
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count() % 1000000;
+        std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+        return fmt::format("{:%Y-%m-%d %H:%M:%S}.{:06}+00", fmt::gmtime(seconds), micros);
+    }
+
+} // namespace game_server
@@ -0,0 +1,13 @@
+﻿// util/time_util.h
+#pragma once
+#include <string>
+
+namespace game_server {
+
+    class TimeUtil {
+    public:
+        // DB 기본값(CURRENT_TIMESTAMP)을 문자열로 읽었을 때와 같은 형식의 현재 UTC 시각
+        static std::string currentTimestamp();
+    };
+
+} // namespace game_server
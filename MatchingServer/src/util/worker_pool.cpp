@@ -0,0 +1,93 @@
+﻿// util/worker_pool.cpp
+// 워커 풀 구현 파일
+// 제한된 대기열과 고정 개수의 워커 스레드로 블로킹 작업을 실행
+#include "worker_pool.h"
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    WorkerPool::WorkerPool(int threadCount, std::size_t queueLimit, std::string name)
+        : queue_limit_(queueLimit), name_(std::move(name))
+    {
+        threads_.reserve(threadCount);
+        for (int i = 0; i < threadCount; ++i) {
+            threads_.emplace_back([this]() { worker_loop(); });
+        }
+        spdlog::info("{} 초기화 완료, 스레드 수 : {}, 대기열 한도 : {}", name_, threadCount, queueLimit);
+    }
+
+    WorkerPool::~WorkerPool() {
+        stop();
+    }
+
+    bool WorkerPool::submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_ || queue_.size() >= queue_limit_) {
+                ++rejected_;
+                return false;
+            }
+            queue_.push_back(std::move(task));
+            if (queue_.size() > max_queue_depth_) {
+                max_queue_depth_ = queue_.size();
+            }
+        }
+        ++submitted_;
+        cv_.notify_one();
+        return true;
+    }
+
+    void WorkerPool::stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) return;
+            stopping_ = true;
+        }
+        cv_.notify_all();
+
+        for (auto& thread : threads_) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+        spdlog::info("{} 중단", name_);
+    }
+
+    WorkerPool::Metrics WorkerPool::getMetrics() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return Metrics{
+            threads_.size(),
+            queue_.size(),
+            max_queue_depth_,
+            queue_limit_,
+            active_workers_.load(),
+            submitted_.load(),
+            completed_.load(),
+            rejected_.load()
+        };
+    }
+
+    void WorkerPool::worker_loop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) return;  // 중지 요청 및 남은 작업 없음
+                task = std::move(queue_.front());
+                queue_.pop_front();
+            }
+
+            ++active_workers_;
+            try {
+                task();
+            }
+            catch (const std::exception& e) {
+                spdlog::error("워커 작업 실행 중 예외가 발생하였습니다: {}", e.what());
+            }
+            --active_workers_;
+            ++completed_;
+        }
+    }
+
+} // namespace game_server
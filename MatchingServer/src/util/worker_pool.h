@@ -0,0 +1,60 @@
+﻿// util/worker_pool.h
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace game_server {
+
+    // 컨트롤러/서비스/리포지토리처럼 블로킹되는 작업을 네트워크 스레드 밖에서 실행하는 워커 풀
+    // 대기열 크기가 제한되어 있어 DB가 느려져도 메모리가 무한히 늘지 않음
+    class WorkerPool {
+    public:
+        struct Metrics {
+            std::size_t threads;
+            std::size_t queueDepth;
+            std::size_t maxQueueDepth;
+            std::size_t queueLimit;
+            std::size_t activeWorkers;
+            std::uint64_t submitted;
+            std::uint64_t completed;
+            std::uint64_t rejected;
+        };
+
+        // name은 로그 구분용
+        WorkerPool(int threadCount, std::size_t queueLimit, std::string name = "워커 풀");
+        ~WorkerPool();
+
+        // 작업 추가, 대기열이 가득 찼거나 중지된 경우 false
+        bool submit(std::function<void()> task);
+
+        // 남은 작업을 모두 처리한 뒤 워커 스레드 종료
+        void stop();
+
+        Metrics getMetrics() const;
+
+    private:
+        void worker_loop();
+
+        std::vector<std::thread> threads_;
+        std::deque<std::function<void()>> queue_;
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        const std::size_t queue_limit_;
+        const std::string name_;
+        std::size_t max_queue_depth_ = 0;
+        bool stopping_ = false;
+
+        std::atomic<std::size_t> active_workers_{ 0 };
+        std::atomic<std::uint64_t> submitted_{ 0 };
+        std::atomic<std::uint64_t> completed_{ 0 };
+        std::atomic<std::uint64_t> rejected_{ 0 };
+    };
+
+} // namespace game_server
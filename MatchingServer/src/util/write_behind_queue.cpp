@@ -0,0 +1,94 @@
+﻿// util/write_behind_queue.cpp
+// write-behind 큐 구현 파일
+// 변경 묶음마다 파이프라인 구간(암묵적 트랜잭션) 하나를 만들어 실패한 묶음은 그 묶음만 롤백되게 함
+// 재연결 후 다시 전송된 묶음이 한 번 더 실행될 수 있으므로 기록하는 문장은 모두 반복 실행해도 결과가 같아야 함
+#include "write_behind_queue.h"
+#include <future>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    WriteBehindQueue::WriteBehindQueue(const std::string& connectionString, AsyncPgClient::Catalog catalog)
+        : work_guard_(boost::asio::make_work_guard(io_context_)),
+        client_(std::make_shared<AsyncPgClient>(io_context_, connectionString, std::move(catalog)))
+    {
+        client_->start();
+        thread_ = std::thread([this]() {
+            for (;;) {
+                try {
+                    io_context_.run();
+                    break;
+                }
+                catch (const std::exception& e) {
+                    spdlog::error("write-behind IO 스레드에서 처리되지 않은 예외 발생: {}", e.what());
+                }
+            }
+            });
+    }
+
+    WriteBehindQueue::~WriteBehindQueue() {
+        stop();
+    }
+
+    void WriteBehindQueue::enqueue(std::vector<Statement> statements) {
+        if (statements.empty()) return;
+        if (stopped_) {
+            // 종료 후에는 전송할 IO 스레드가 없으므로 버림
+            ++failed_;
+            spdlog::warn("write-behind 큐 종료 후 들어온 변경 사항을 버립니다: {}", statements.front().name);
+            return;
+        }
+
+        auto enqueued = ++enqueued_;
+        std::size_t pending = enqueued - written_ - failed_;
+        std::size_t max_pending = max_pending_;
+        while (pending > max_pending && !max_pending_.compare_exchange_weak(max_pending, pending)) {}
+
+        std::string first = statements.front().name;
+        client_->execute(std::move(statements), [this, first](AsyncPgClient::Result result) {
+            if (result.ok) {
+                ++written_;
+            }
+            else {
+                ++failed_;
+                spdlog::error("write-behind 기록 실패로 변경 사항을 버립니다: {}, {}", first, result.error);
+            }
+            });
+    }
+
+    void WriteBehindQueue::stop() {
+        if (stopped_.exchange(true)) return;
+
+        // 남은 변경 사항 기록을 제한 시간 동안 기다림 (DB가 내려가 있으면 포기)
+        auto drained = std::make_shared<std::promise<void>>();
+        auto future = drained->get_future();
+        client_->async_drain([drained]() { drained->set_value(); });
+        if (future.wait_for(kDrainTimeout) != std::future_status::ready) {
+            spdlog::error("write-behind 큐를 비우지 못하고 종료합니다, 남은 변경 사항 {}건",
+                enqueued_ - written_ - failed_);
+        }
+
+        client_->close();
+        work_guard_.reset();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        spdlog::info("write-behind 큐 종료, 기록 {}건, 실패 {}건", written_.load(), failed_.load());
+    }
+
+    WriteBehindQueue::Metrics WriteBehindQueue::getMetrics() const {
+        auto client = client_->getMetrics();
+        Metrics metrics;
+        metrics.connected = client.connected;
+        metrics.pending = client.queued + client.inFlight;
+        metrics.maxPending = max_pending_;
+        metrics.enqueued = enqueued_;
+        metrics.written = written_;
+        metrics.failed = failed_;
+        metrics.retried = client.retried;
+        metrics.batches = client.batches;
+        metrics.reconnects = client.reconnects;
+        return metrics;
+    }
+
+} // namespace game_server
@@ -0,0 +1,75 @@
+﻿// util/write_behind_queue.h
+#pragma once
+#include "async_pg_client.h"
+#include <boost/asio.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace game_server {
+
+    // 메모리 상태 변경을 DB에 비동기로 반영하는 write-behind 큐
+    // 전용 IO 스레드의 비동기 PostgreSQL 연결로 추가된 순서대로 파이프라인 전송
+    class WriteBehindQueue {
+    public:
+        using Statement = AsyncPgClient::Statement;
+
+        struct Metrics {
+            bool connected;
+            std::size_t pending;
+            std::size_t maxPending;
+            std::uint64_t enqueued;
+            std::uint64_t written;
+            std::uint64_t failed;
+            std::uint64_t retried;
+            std::uint64_t batches;
+            std::uint64_t reconnects;
+        };
+
+        WriteBehindQueue(const std::string& connectionString, AsyncPgClient::Catalog catalog);
+        ~WriteBehindQueue();
+
+        template <typename... Args>
+        static Statement statement(const char* name, const Args&... args) {
+            return Statement{ name, { toParam(args)... } };
+        }
+
+        // 함께 적용되어야 하는 문장 묶음 추가 (묶음 단위로 하나의 트랜잭션으로 기록)
+        // 실패한 묶음은 그 묶음만 롤백되며, 재전송으로 두 번 실행될 수 있으므로 문장은 멱등이어야 함
+        void enqueue(std::vector<Statement> statements);
+
+        // 남은 변경 사항을 기록할 때까지 기다린 뒤 연결과 스레드 종료
+        void stop();
+
+        Metrics getMetrics() const;
+
+    private:
+        template <typename T>
+        static std::string toParam(const T& value) {
+            if constexpr (std::is_arithmetic_v<T>) {
+                return std::to_string(value);
+            }
+            else {
+                return std::string(value);
+            }
+        }
+
+        static constexpr auto kDrainTimeout = std::chrono::seconds(5);
+
+        boost::asio::io_context io_context_;
+        boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard_;
+        std::shared_ptr<AsyncPgClient> client_;
+        std::thread thread_;
+        std::atomic<bool> stopped_{ false };
+
+        std::atomic<std::size_t> max_pending_{ 0 };
+        std::atomic<std::uint64_t> enqueued_{ 0 };
+        std::atomic<std::uint64_t> written_{ 0 };
+        std::atomic<std::uint64_t> failed_{ 0 };
+    };
+
+} // namespace game_server
@@ -0,0 +1,152 @@
+﻿// test/message_framer_test.cpp
+// 메시지 프레이머 테스트
+// JSON 프레임 분리와 JSON 핸드셰이크 이후 길이 접두사 프레임으로 전환되는 경계를 확인
+#include "core/message_framer.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace game_server;
+
+namespace {
+
+    int failures = 0;
+
+    void expect(bool condition, const char* description) {
+        if (!condition) {
+            std::printf("실패: %s\n", description);
+            ++failures;
+        }
+    }
+
+    std::string binaryFrame(const std::string& payload) {
+        std::string frame;
+        std::size_t length = payload.size();
+        frame.push_back(static_cast<char>((length >> 24) & 0xFF));
+        frame.push_back(static_cast<char>((length >> 16) & 0xFF));
+        frame.push_back(static_cast<char>((length >> 8) & 0xFF));
+        frame.push_back(static_cast<char>(length & 0xFF));
+        return frame + payload;
+    }
+
+    bool feed(MessageFramer& framer, const std::string& data) {
+        return framer.append(data.data(), data.size());
+    }
+
+    // 한 프레임이 여러 번의 읽기에 나눠 도착
+    void jsonFrameSplitAcrossReads() {
+        MessageFramer framer;
+        std::string frame;
+        feed(framer, "{\"action\":\"ping\",");
+        expect(!framer.next(frame), "닫는 괄호 도착 전에는 프레임 없음");
+        feed(framer, "\"data\":[1,2");
+        expect(!framer.next(frame), "중첩 배열이 닫히기 전에는 프레임 없음");
+        feed(framer, "]}\n");
+        expect(framer.next(frame) && frame == "{\"action\":\"ping\",\"data\":[1,2]}", "나눠 도착한 JSON 프레임");
+        expect(!framer.next(frame), "남은 프레임 없음");
+    }
+
+    // 개행 구분 프레임과 구분자 없이 이어 붙인 프레임이 한 번에 도착
+    void multipleJsonFramesInOneRead() {
+        MessageFramer framer;
+        std::string frame;
+        feed(framer, "{\"a\":1}\n{\"b\":2}{\"c\":3} [4]\r\n{\"d\"");
+
+        expect(framer.next(frame) && frame == "{\"a\":1}", "첫 번째 프레임");
+        expect(framer.next(frame) && frame == "{\"b\":2}", "개행 뒤 프레임");
+        expect(framer.next(frame) && frame == "{\"c\":3}", "구분자 없이 이어진 프레임");
+        expect(framer.next(frame) && frame == "[4]", "최상위 배열 프레임");
+        expect(!framer.next(frame), "미완성 프레임은 꺼내지 않음");
+        feed(framer, ":4}");
+        expect(framer.next(frame) && frame == "{\"d\":4}", "이어서 완성된 프레임");
+    }
+
+    // 문자열 안의 괄호와 이스케이프된 따옴표는 중첩 깊이에 반영하지 않음
+    void bracesAndEscapedQuotesInStrings() {
+        MessageFramer framer;
+        std::string frame;
+        const std::string message = "{\"message\":\"}{ [\\\"}\\\\\",\"next\":\"]\"}";
+        feed(framer, message.substr(0, 16));
+        expect(!framer.next(frame), "문자열 안의 닫는 괄호에서 프레임을 끊지 않음");
+        feed(framer, message.substr(16) + "{}");
+        expect(framer.next(frame) && frame == message, "문자열에 괄호와 따옴표가 있는 프레임");
+        expect(framer.next(frame) && frame == "{}", "다음 프레임");
+    }
+
+    // 미완성 프레임이 최대 크기를 넘으면 거부, 꺼낸 프레임은 크기에 포함하지 않음
+    void frameSizeLimit() {
+        MessageFramer framer;
+        std::string frame;
+        std::string body(MessageFramer::kMaxFrameSize - 2, 'x');
+        expect(feed(framer, "[\"" + body), "최대 크기까지는 허용");
+        expect(!framer.next(frame), "미완성 프레임");
+        expect(!feed(framer, "\""), "최대 크기를 넘는 데이터는 거부");
+
+        MessageFramer drained;
+        std::string half(MessageFramer::kMaxFrameSize / 2, 'y');
+        expect(feed(drained, "[\"" + half + "\"]"), "첫 프레임");
+        expect(drained.next(frame) && frame.size() == half.size() + 4, "첫 프레임 꺼냄");
+        expect(feed(drained, "[\"" + half + "\"]"), "꺼낸 프레임만큼 다시 받을 수 있음");
+        expect(drained.next(frame) && frame.size() == half.size() + 4, "두 번째 프레임 꺼냄");
+    }
+
+    // 핸드셰이크와 개행, 바이너리 프레임 두 개가 한 번에 도착
+    void handshakeThenBinaryInOneRead() {
+        MessageFramer framer;
+        std::string frame;
+        feed(framer, "{\"version\":\"1.0.0\",\"encoding\":\"msgpack\"}\n" + binaryFrame("first") + binaryFrame("second"));
+
+        expect(framer.next(frame) && frame == "{\"version\":\"1.0.0\",\"encoding\":\"msgpack\"}", "핸드셰이크 JSON 프레임");
+        framer.setLengthPrefixed();
+        expect(framer.next(frame) && frame == "first", "개행 뒤 첫 바이너리 프레임");
+        expect(framer.next(frame) && frame == "second", "두 번째 바이너리 프레임");
+        expect(!framer.next(frame), "남은 프레임 없음");
+    }
+
+    // 핸드셰이크 뒤의 개행이 다음 읽기에서 도착
+    void delimiterInNextRead() {
+        MessageFramer framer;
+        std::string frame;
+        feed(framer, "{\"encoding\":\"cbor\"}");
+
+        expect(framer.next(frame), "핸드셰이크 JSON 프레임");
+        framer.setLengthPrefixed();
+        expect(!framer.next(frame), "개행 도착 전에는 프레임 없음");
+
+        feed(framer, "\r\n" + binaryFrame("payload").substr(0, 3));
+        expect(!framer.next(frame), "길이 헤더가 모두 도착하기 전에는 프레임 없음");
+        feed(framer, binaryFrame("payload").substr(3) + binaryFrame(std::string(1, '\n')));
+        expect(framer.next(frame) && frame == "payload", "나눠 도착한 바이너리 프레임");
+        expect(framer.next(frame) && frame == "\n", "개행으로 시작하는 본문은 건너뛰지 않음");
+    }
+
+    // 길이가 0인 프레임도 구분자로 오인하지 않음
+    void emptyBinaryFrame() {
+        MessageFramer framer;
+        std::string frame;
+        feed(framer, "{}\n" + binaryFrame("") + binaryFrame("x"));
+
+        expect(framer.next(frame) && frame == "{}", "핸드셰이크 JSON 프레임");
+        framer.setLengthPrefixed();
+        expect(framer.next(frame) && frame.empty(), "빈 바이너리 프레임");
+        expect(framer.next(frame) && frame == "x", "빈 프레임 다음 프레임");
+    }
+
+} // namespace
+
+int main() {
+    jsonFrameSplitAcrossReads();
+    multipleJsonFramesInOneRead();
+    bracesAndEscapedQuotesInStrings();
+    frameSizeLimit();
+    handshakeThenBinaryInOneRead();
+    delimiterInNextRead();
+    emptyBinaryFrame();
+
+    if (failures > 0) {
+        std::printf("message_framer_test: %d개 실패\n", failures);
+        return EXIT_FAILURE;
+    }
+    std::printf("message_framer_test: 통과\n");
+    return EXIT_SUCCESS;
+}